@@ -44,6 +44,9 @@ public:
 	virtual void on_resolve (resolve_event event) override {
 		std::cout << "Resolve request for " << module_loader::type_name(event.request().type()) << " by " << event.requester().name() << " with " << event.provider().name() << std::endl;
 	}
+	virtual void on_begin_create (begin_create_event event) override {
+		std::cout << "Creating " << event.offer().name() << std::endl;
+	}
 	virtual void on_create (create_event event) override {
 		std::cout << "Created " << event.object().name() << std::endl;
 	}
@@ -0,0 +1,129 @@
+/**
+ *	\file
+ */
+
+#pragma once
+
+#include "offer.hpp"
+#include "offer_factory.hpp"
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace module_loader {
+
+/**
+ *	An \ref offer_factory which pulls \ref offer
+ *	objects from another \ref offer_factory on a
+ *	background thread.
+ *
+ *	The wrapped \ref offer_factory is drained as
+ *	quickly as it can produce \ref offer objects
+ *	and those objects are buffered until they are
+ *	retrieved.  When wrapped around an \ref offer_factory
+ *	whose \ref offer_factory::next is expensive (e.g.
+ *	\ref shared_library_offer_factory, which loads
+ *	shared libraries and invokes their load handlers)
+ *	this allows a consumer such as \ref dag_resolver to
+ *	index \ref offer objects into its dependency graph
+ *	while subsequent \ref offer objects are still being
+ *	produced.
+ *
+ *	This is prefetching only.  \ref dag_resolver does
+ *	not construct any object until the wrapped
+ *	\ref offer_factory has been exhausted, so the
+ *	construction of objects (even those whose
+ *	\ref offer has no requests) never overlaps the
+ *	production of later \ref offer objects.
+ *
+ *	\ref offer objects are yielded in exactly the order
+ *	in which the wrapped \ref offer_factory produces
+ *	them.  If the wrapped \ref offer_factory throws the
+ *	exception is rethrown once all \ref offer objects
+ *	produced before it have been retrieved.
+ *
+ *	The wrapped \ref offer_factory is only ever invoked
+ *	from one thread at a time and need not be thread
+ *	safe, but it must not be used by anything else
+ *	while an asynchronous_offer_factory is draining it.
+ */
+class asynchronous_offer_factory : public offer_factory {
+private:
+	offer_factory & inner_;
+	mutable std::mutex m_;
+	std::condition_variable cv_;
+	std::deque<std::unique_ptr<offer>> q_;
+	std::exception_ptr ex_;
+	//	Sampled by the background thread since the
+	//	wrapped offer_factory may not be invoked from
+	//	any other thread once it has started
+	std::size_t inner_hint_;
+	bool started_;
+	bool done_;
+	bool stop_;
+	std::thread t_;
+	void run () noexcept;
+	void start ();
+	bool wait (std::unique_lock<std::mutex> &);
+public:
+	asynchronous_offer_factory () = delete;
+	/**
+	 *	Creates an asynchronous_offer_factory.
+	 *
+	 *	The background thread is not started until
+	 *	\ref offer objects are first requested.
+	 *
+	 *	\param [in] inner
+	 *		The \ref offer_factory to drain.
+	 */
+	explicit asynchronous_offer_factory (offer_factory & inner);
+	/**
+	 *	Stops the background thread (after the
+	 *	invocation of the wrapped \ref offer_factory
+	 *	which is in progress, if any, completes) and
+	 *	discards any buffered \ref offer objects.
+	 */
+	~asynchronous_offer_factory () noexcept;
+	virtual std::unique_ptr<offer> next () override;
+	virtual std::shared_ptr<offer> next_shared () override;
+	/**
+	 *	Retrieves up to \em max \ref offer objects.
+	 *
+	 *	Since a short batch signals exhaustion this waits
+	 *	until \em max \ref offer objects have been buffered
+	 *	or the wrapped \ref offer_factory is exhausted.  A
+	 *	consumer which retrieves in batches (e.g.
+	 *	\ref dag_resolver) therefore cannot index an
+	 *	\ref offer until the rest of its batch has been
+	 *	produced.  Use \ref next to retrieve each
+	 *	\ref offer as soon as it is produced.
+	 *
+	 *	\param [in] batch
+	 *		The container to which the \ref offer objects
+	 *		are appended.
+	 *	\param [in] max
+	 *		The maximum number of \ref offer objects to
+	 *		retrieve.
+	 *
+	 *	\return
+	 *		The number of \ref offer objects appended to
+	 *		\em batch.
+	 */
+	virtual std::size_t next_batch (batch_type & batch, std::size_t max) override;
+	/**
+	 *	Estimates the number of \ref offer objects which
+	 *	remain as the number which are buffered plus the
+	 *	estimate of the wrapped \ref offer_factory (as of
+	 *	when it last produced an \ref offer).
+	 *
+	 *	\return
+	 *		The estimated number of \ref offer objects.
+	 */
+	virtual std::size_t size_hint () const noexcept override;
+};
+
+}
@@ -0,0 +1,211 @@
+/**
+ *	\file
+ */
+
+#pragma once
+
+#include "directory_entry_filter.hpp"
+#include "directory_scanning_shared_library_factory_observer.hpp"
+#include "load_policy.hpp"
+#include "optional.hpp"
+#include "shared_library_factory.hpp"
+#include <boost/dll/shared_library.hpp>
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <future>
+#include <set>
+#include <vector>
+
+namespace module_loader {
+
+/**
+ *	Scans directories loading all shared libraries
+ *	found therein and yielding them.
+ *
+ *	Unlike \ref directory_scanning_shared_library_factory
+ *	all directories are enumerated concurrently, by a fixed
+ *	number of threads (see \ref concurrency), as soon as
+ *	the first shared library is requested.  Enumeration uses the file type reported by
+ *	the directory listing itself (where the platform
+ *	provides it) so that boost::filesystem::directory_entry::symlink_status
+ *	does not need to stat each file.
+ *
+ *	Shared libraries are yielded in a consistent order:
+ *	Directories are consumed in the order in which they
+ *	sort and the shared libraries within each directory
+ *	(and, when scanning recursively, its subdirectories)
+ *	are yielded in the order in which their paths sort.
+ *	The \ref directory_entry_filter (if any) and the
+ *	\ref directory_scanning_shared_library_factory_observer
+ *	(if any) are only ever invoked from the thread which
+ *	invokes \ref next.  The \ref directory_entry_filter is
+ *	applied to all entries in a directory when that
+ *	directory is reached.
+ *
+ *	Optionally the files which will be loaded next may
+ *	be read ahead into the page cache (see \ref readahead)
+ *	while the current shared library is being loaded.
+ */
+class concurrent_directory_scanning_shared_library_factory : public shared_library_factory {
+private:
+	using paths_type = std::set<boost::filesystem::path>;
+	using entries_type = std::vector<boost::filesystem::directory_entry>;
+	paths_type paths_;
+	bool recursive_;
+	std::size_t concurrency_;
+	std::deque<std::future<entries_type>> scans_;
+	//	Destroying these futures waits for any
+	//	scans which are still in progress
+	std::deque<std::future<void>> workers_;
+	optional<paths_type::const_iterator> path_;
+	entries_type entries_;
+	std::size_t entry_;
+	std::size_t prefetched_;
+	std::size_t readahead_;
+	bool populate_;
+	std::deque<std::future<void>> populating_;
+	directory_entry_filter * filter_;
+	directory_scanning_shared_library_factory_observer * o_;
+	load_policy policy_;
+	void start ();
+	bool next_path ();
+	const boost::filesystem::directory_entry * next_library ();
+	void prefetch ();
+	void dispatch_begin_directory () const;
+	void dispatch_end_directory () const;
+	void dispatch_load (const boost::dll::shared_library &, std::chrono::steady_clock::duration) const;
+public:
+	/**
+	 *	Creates a concurrent_directory_scanning_shared_library_factory
+	 *	which does not scan any directories and which filters files
+	 *	it loads as shared libraries using
+	 *	\ref shared_library_directory_entry_filter.
+	 */
+	concurrent_directory_scanning_shared_library_factory ();
+	/**
+	 *	Creates a concurrent_directory_scanning_shared_library_factory
+	 *	which does not scan any directories and which filters the
+	 *	files it attempts to load as shared libraries using a certain
+	 *	\ref directory_entry_filter.
+	 *
+	 *	\param [in] filter
+	 *		The \ref directory_entry_filter.
+	 */
+	explicit concurrent_directory_scanning_shared_library_factory (directory_entry_filter & filter);
+	/**
+	 *	Creates a concurrent_directory_scanning_shared_library_factory
+	 *	which does not scan any directories, which filters files it
+	 *	loads as shared libraries using \ref shared_library_directory_entry_filter,
+	 *	and which dispatches events to a certain
+	 *	\ref directory_scanning_shared_library_factory_observer.
+	 *
+	 *	\param [in] o
+	 *		The \ref directory_scanning_shared_library_factory_observer.
+	 */
+	explicit concurrent_directory_scanning_shared_library_factory (directory_scanning_shared_library_factory_observer & o);
+	/**
+	 *	Creates a concurrent_directory_scanning_shared_library_factory
+	 *	which does not scan any directory, which filters the files
+	 *	it attempts to load as shared libraries using a certain
+	 *	\ref directory_entry_filter, and which dispatches events
+	 *	to a certain \ref directory_scanning_shared_library_factory_observer.
+	 *
+	 *	\param [in] filter
+	 *		The \ref directory_entry_filter.
+	 *	\param [in] o
+	 *		The \ref directory_scanning_shared_library_factory_observer.
+	 */
+	concurrent_directory_scanning_shared_library_factory (directory_entry_filter & filter, directory_scanning_shared_library_factory_observer & o);
+	virtual boost::dll::shared_library next () override;
+	/**
+	 *	Adds a directory to scan.
+	 *
+	 *	May not be invoked once \ref next has been
+	 *	invoked.
+	 *
+	 *	\param [in] path
+	 *		A path to the directory to scan.
+	 *
+	 *	\return
+	 *		\em true if \em path was added, \em false
+	 *		otherwise.
+	 */
+	bool add (boost::filesystem::path path);
+	/**
+	 *	Determines whether subdirectories of each
+	 *	directory shall be scanned.  Defaults to
+	 *	\em false.
+	 *
+	 *	Symbolic links to directories are never
+	 *	followed.  May not be invoked once \ref next
+	 *	has been invoked.
+	 *
+	 *	\param [in] recursive
+	 *		\em true to scan subdirectories, \em false
+	 *		otherwise.
+	 */
+	void recursive (bool recursive);
+	/**
+	 *	Sets the maximum number of threads which shall
+	 *	enumerate directories.  The same number bounds
+	 *	the threads which fault in pages when reading
+	 *	ahead (see \ref readahead).  Defaults to the
+	 *	number of hardware threads.
+	 *
+	 *	May not be invoked once \ref next has been
+	 *	invoked.
+	 *
+	 *	\param [in] n
+	 *		The number of threads.  Zero is treated as
+	 *		one.
+	 */
+	void concurrency (std::size_t n);
+	/**
+	 *	Retrieves the maximum number of threads which
+	 *	enumerate directories.
+	 *
+	 *	\return
+	 *		The number of threads.
+	 */
+	std::size_t concurrency () const noexcept;
+	/**
+	 *	Sets the \ref load_policy according to which
+	 *	shared libraries are opened.  Affects only those
+	 *	shared libraries opened subsequently.
+	 *
+	 *	\param [in] policy
+	 *		The \ref load_policy.
+	 */
+	void policy (load_policy policy) noexcept;
+	/**
+	 *	Retrieves the \ref load_policy according to
+	 *	which shared libraries are opened.
+	 *
+	 *	\return
+	 *		The \ref load_policy.
+	 */
+	const load_policy & policy () const noexcept;
+	/**
+	 *	Determines how many shared libraries beyond the
+	 *	one being loaded shall be read ahead into the
+	 *	page cache.  Defaults to 0.
+	 *
+	 *	Read ahead does not cross directory boundaries.
+	 *	May not be invoked once \ref next has been
+	 *	invoked.
+	 *
+	 *	\param [in] count
+	 *		The number of shared libraries.
+	 *	\param [in] populate
+	 *		\em true if the files shall additionally be
+	 *		mapped and their pages faulted in (this is
+	 *		done on background threads, but never on more
+	 *		than \ref concurrency at once), \em false
+	 *		otherwise.  Defaults to \em false.
+	 */
+	void readahead (std::size_t count, bool populate = false);
+};
+
+}
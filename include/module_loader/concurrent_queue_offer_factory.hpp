@@ -0,0 +1,124 @@
+/**
+ *	\file
+ */
+
+#pragma once
+
+#include "offer.hpp"
+#include "offer_factory.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace module_loader {
+
+/**
+ *	A \ref offer_factory which pops \ref offer
+ *	objects from a queue to which any number of
+ *	threads may add concurrently.
+ *
+ *	\ref add is lock free and may be invoked from
+ *	any thread at any time, including while \ref offer
+ *	objects are being retrieved.  Retrieval (i.e.
+ *	\ref next, \ref next_shared, and \ref next_batch)
+ *	must only be performed by one thread at a time.
+ *
+ *	Each \ref offer is added on behalf of a producer,
+ *	identified by a number chosen by the caller.
+ *	\ref offer objects are yielded in ascending order
+ *	of producer and those from the same producer in
+ *	the order in which they were added.  So long as
+ *	each producer adds from only one thread at a time
+ *	and all \ref offer objects are added before they
+ *	are retrieved the order in which they are yielded
+ *	is therefore the same on every run regardless of
+ *	how the threads which add them are scheduled (which
+ *	matters since \ref dag_resolver breaks ties between
+ *	providers, and \ref resolution_plan identifies
+ *	\ref offer objects, by the order in which they are
+ *	yielded).  \ref offer objects added while others
+ *	are being retrieved are yielded after those which
+ *	have already been yielded, even if they belong to
+ *	an earlier producer.
+ *
+ *	Like \ref queue_offer_factory an empty queue is
+ *	reported as exhaustion, so consumers which stop
+ *	at exhaustion (e.g. \ref offer_factory_composite)
+ *	should not be given a concurrent_queue_offer_factory
+ *	until all threads have finished adding to it.
+ */
+class concurrent_queue_offer_factory : public offer_factory {
+private:
+	class node {
+	public:
+		std::unique_ptr<module_loader::offer> value;
+		std::size_t producer;
+		std::uint64_t sequence;
+		node * next;
+	};
+	//	Producers push onto the front of this list
+	//	which the consumer detaches wholesale, sorts,
+	//	and merges into the list formed by front_ and
+	//	back_
+	std::atomic<node *> head_;
+	std::atomic<std::uint64_t> sequence_;
+	std::atomic<std::size_t> size_;
+	node * front_;
+	node * back_;
+	static void destroy (node *) noexcept;
+	static bool before (const node &, const node &) noexcept;
+	static node * merge (node *, node *) noexcept;
+	static node * sort (node *) noexcept;
+	bool drain () noexcept;
+	std::unique_ptr<offer> pop () noexcept;
+public:
+	concurrent_queue_offer_factory () noexcept;
+	concurrent_queue_offer_factory (const concurrent_queue_offer_factory &) = delete;
+	concurrent_queue_offer_factory (concurrent_queue_offer_factory &&) = delete;
+	concurrent_queue_offer_factory & operator = (const concurrent_queue_offer_factory &) = delete;
+	concurrent_queue_offer_factory & operator = (concurrent_queue_offer_factory &&) = delete;
+	/**
+	 *	Destroys all \ref offer objects which have
+	 *	not been retrieved.
+	 */
+	~concurrent_queue_offer_factory () noexcept;
+	/**
+	 *	Adds a \ref offer to the queue on behalf of
+	 *	a certain producer.
+	 *
+	 *	This function is thread safe.
+	 *
+	 *	\param [in] producer
+	 *		The number which identifies the producer.
+	 *	\param [in] req
+	 *		A std::unique_ptr to the \ref offer
+	 *		to add.
+	 */
+	void add (std::size_t producer, std::unique_ptr<offer> req);
+	/**
+	 *	Adds a \ref offer to the queue on behalf of
+	 *	producer 0.
+	 *
+	 *	This function is thread safe.
+	 *
+	 *	\param [in] req
+	 *		A std::unique_ptr to the \ref offer
+	 *		to add.
+	 */
+	void add (std::unique_ptr<offer> req);
+	virtual std::unique_ptr<offer> next () override;
+	virtual std::shared_ptr<offer> next_shared () override;
+	virtual std::size_t next_batch (batch_type & batch, std::size_t max) override;
+	/**
+	 *	Returns the number of \ref offer objects which
+	 *	have been added but not yet retrieved.  May be
+	 *	out of date if other threads are adding.
+	 *
+	 *	\return
+	 *		The number of \ref offer objects.
+	 */
+	virtual std::size_t size_hint () const noexcept override;
+};
+
+}
@@ -0,0 +1,100 @@
+/**
+ *	\file
+ */
+
+#pragma once
+
+#include "offer.hpp"
+#include "optional.hpp"
+#include <chrono>
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+
+namespace module_loader {
+
+/**
+ *	Records how long fulfilling each \ref offer took
+ *	so that a later \ref dag_resolver may schedule the
+ *	construction of objects accordingly.
+ *
+ *	\ref offer objects are identified by their name and
+ *	the type they provide so that a profile remains
+ *	useful as \ref offer objects are added and removed.
+ *
+ *	Profiles may be written to and read from a compact
+ *	binary representation.
+ */
+class construction_profile {
+public:
+	/**
+	 *	The type used to represent durations.
+	 */
+	using duration = std::chrono::nanoseconds;
+private:
+	std::unordered_map<std::string,duration::rep> durations_;
+	static std::string key (const offer &);
+public:
+	/**
+	 *	Creates an empty construction_profile.
+	 */
+	construction_profile () = default;
+	construction_profile (const construction_profile &) = default;
+	construction_profile (construction_profile &&) = default;
+	construction_profile & operator = (const construction_profile &) = default;
+	construction_profile & operator = (construction_profile &&) = default;
+	/**
+	 *	Determines the number of \ref offer objects
+	 *	for which a duration has been recorded.
+	 *
+	 *	\return
+	 *		The number of \ref offer objects.
+	 */
+	std::size_t size () const noexcept;
+	/**
+	 *	Records how long fulfilling an \ref offer took,
+	 *	replacing any duration previously recorded for it.
+	 *
+	 *	\param [in] o
+	 *		The \ref offer.
+	 *	\param [in] d
+	 *		The duration.
+	 */
+	void record (const offer & o, duration d);
+	/**
+	 *	Retrieves how long fulfilling an \ref offer took.
+	 *
+	 *	\param [in] o
+	 *		The \ref offer.
+	 *
+	 *	\return
+	 *		The duration or nullopt if none has been
+	 *		recorded.
+	 */
+	optional<duration> find (const offer & o) const;
+	/**
+	 *	Writes the binary representation of this profile.
+	 *
+	 *	\param [in] os
+	 *		The stream to which to write.  Should be
+	 *		opened in binary mode.
+	 */
+	void write (std::ostream & os) const;
+	/**
+	 *	Reads a profile from its binary representation.
+	 *
+	 *	\param [in] is
+	 *		The stream from which to read.  Should be
+	 *		opened in binary mode.
+	 *
+	 *	\return
+	 *		The construction_profile.  If the stream does
+	 *		not contain a profile written by \ref write
+	 *		throws \ref error.
+	 */
+	static construction_profile read (std::istream & is);
+};
+
+}
@@ -17,6 +17,7 @@ namespace module_loader {
 class counting_resolver_observer : public resolver_observer {
 private:
 	std::size_t resolve_;
+	std::size_t begin_create_;
 	std::size_t create_;
 	std::size_t destroy_;
 public:
@@ -25,6 +26,7 @@ public:
 	 */
 	counting_resolver_observer ();
 	virtual void on_resolve (resolve_event) override;
+	virtual void on_begin_create (begin_create_event) override;
 	virtual void on_create (create_event) override;
 	virtual void on_destroy (destroy_event) override;
 	/**
@@ -35,6 +37,14 @@ public:
 	 *		The count.
 	 */
 	std::size_t resolve () const noexcept;
+	/**
+	 *	Determines the number of times \ref on_begin_create
+	 *	has been invoked.
+	 *
+	 *	\return
+	 *		The count.
+	 */
+	std::size_t begin_create () const noexcept;
 	/**
 	 *	Determines the number of times \ref on_create
 	 *	has been invoked.
@@ -4,16 +4,24 @@
 
 #pragma once
 
+#include "construction_profile.hpp"
+#include "not_a_dag_error.hpp"
 #include "object.hpp"
 #include "offer.hpp"
+#include "offer_catalog.hpp"
 #include "offer_factory.hpp"
 #include "optional.hpp"
+#include "resolution_plan.hpp"
 #include "resolver_observer.hpp"
+#include "resolver_statistics.hpp"
 #include "unfulfilled_error.hpp"
+#include <chrono>
 #include <cstddef>
 #include <memory>
+#include <mutex>
 #include <typeindex>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace module_loader {
@@ -26,45 +34,145 @@ namespace module_loader {
  *	objects may be constructed.
  */
 class dag_resolver {
+public:
+	/**
+	 *	Describes the outcome of attempting to
+	 *	resolve a dependency graph without
+	 *	constructing any objects.
+	 */
+	class result {
+	private:
+		unfulfilled_error::entries_type unfulfilled_;
+		not_a_dag_error::cycles_type cycles_;
+	public:
+		result () = default;
+		result (const result &) = default;
+		result (result &&) = default;
+		result & operator = (const result &) = default;
+		result & operator = (result &&) = default;
+		/**
+		 *	Creates a result.
+		 *
+		 *	\param [in] unfulfilled
+		 *		The offers whose requests could not be
+		 *		fulfilled.
+		 *	\param [in] cycles
+		 *		The cycles in the dependency graph.
+		 */
+		result (unfulfilled_error::entries_type unfulfilled, not_a_dag_error::cycles_type cycles) noexcept;
+		/**
+		 *	Retrieves the offers whose requests could
+		 *	not be fulfilled.
+		 *
+		 *	\return
+		 *		A collection which is the same as would be
+		 *		carried by the \ref unfulfilled_error thrown
+		 *		by \ref resolve.
+		 */
+		const unfulfilled_error::entries_type & unfulfilled () const noexcept;
+		/**
+		 *	Retrieves the cycles in the dependency graph.
+		 *
+		 *	\return
+		 *		A collection which is the same as would be
+		 *		carried by the \ref not_a_dag_error thrown
+		 *		by \ref resolve.
+		 */
+		const not_a_dag_error::cycles_type & cycles () const noexcept;
+		/**
+		 *	Determines whether the dependency graph could
+		 *	be resolved.
+		 *
+		 *	\return
+		 *		\em true if there are neither unfulfilled
+		 *		requests nor cycles, \em false otherwise.
+		 */
+		explicit operator bool () const noexcept;
+	};
 private:
-	offer_factory & of_;
+	offer_factory * of_;
+	const offer_catalog * catalog_;
 	resolver_observer * ro_;
+	resolver_statistics * stats_;
+	construction_profile * profile_;
+	std::size_t concurrency_;
 	class node {
-	public:
-		using children_type = std::vector<node *>;
 	private:
+		using index_type = std::vector<std::pair<std::type_index,std::size_t>>;
 		std::shared_ptr<module_loader::offer> offer_;
-		std::vector<std::vector<node *>> depends_on_;
-		children_type depended_on_by_;
-		object * object_;
+		//	Both sorted by type so that they may be
+		//	searched in logarithmic time
+		index_type requests_;
+		index_type positions_;
+		static index_type::const_iterator find (const index_type &, const std::type_index &) noexcept;
 	public:
 		node () = delete;
 		node (const node &) = delete;
-		node (node &&) = delete;
+		node (node &&) = default;
 		node & operator = (const node &) = delete;
-		node & operator = (node &&) = delete;
+		node & operator = (node &&) = default;
 		explicit node (std::shared_ptr<module_loader::offer>);
-		bool ordered_before (const node &, const std::type_index &) const noexcept;
+		const request * find_request (const std::type_index &) const noexcept;
+		optional<std::size_t> position (const std::type_index &) const noexcept;
+		void position (const std::type_index &, std::size_t) noexcept;
 		module_loader::offer & offer () noexcept;
 		const module_loader::offer & offer () const noexcept;
 		std::shared_ptr<module_loader::offer> offer_shared () const noexcept;
-		optional<unfulfilled_error::entry> check_fulfilled () const;
-		void resolve (std::size_t i, node &);
-		const children_type & children () const noexcept;
-		std::unique_ptr<object> create ();
-		bool leaf () const noexcept;
-		template <typename Set>
-		bool next (const Set &) const noexcept;
 	};
-	std::vector<std::unique_ptr<node>> nodes_;
-	std::unordered_map<std::type_index,std::vector<node *>> provides_map_;
+	using range_type = std::pair<const std::size_t *,const std::size_t *>;
+	//	Nodes are identified by their position herein
+	//	which is the order in which the offers were
+	//	obtained
+	std::vector<node> nodes_;
+	std::unordered_map<std::type_index,std::vector<std::size_t>> provides_map_;
+	//	The graph is stored as flat arrays indexed by
+	//	node:  The requests of node i are the slots
+	//	[request_offsets_[i],request_offsets_[i + 1]) and
+	//	the providers chosen for slot r are the nodes
+	//	[edge_offsets_[r],edge_offsets_[r + 1]) of edges_
+	std::vector<std::size_t> request_offsets_;
+	std::vector<std::size_t> edge_offsets_;
+	std::vector<std::size_t> edges_;
+	//	The nodes which depend on node i are
+	//	[child_offsets_[i],child_offsets_[i + 1]) of
+	//	children_
+	std::vector<std::size_t> child_offsets_;
+	std::vector<std::size_t> children_;
+	std::vector<unsigned char> status_;
+	std::vector<object *> node_objects_;
+	//	Only populated when recording statistics or a
+	//	construction_profile
+	std::vector<std::chrono::steady_clock::duration> node_durations_;
+	//	The order in which nodes are created
+	std::vector<std::size_t> order_;
 	std::vector<std::unique_ptr<object>> objects_;
-	void do_resolve (node &, std::size_t, node &);
-	std::unique_ptr<object> do_create (node &);
+	optional<resolution_plan> plan_;
+	bool planned_;
+	static constexpr std::size_t batch_size = 64;
+	range_type depends_on (std::size_t, std::size_t) const noexcept;
+	range_type children (std::size_t) const noexcept;
+	void begin_request (std::size_t, std::size_t) noexcept;
+	void do_resolve (std::size_t, std::size_t, std::size_t);
+	bool timed () const noexcept;
+	std::unique_ptr<object> do_create (std::size_t, std::mutex * = nullptr);
 	void get_offers ();
+	void add_offer (std::shared_ptr<module_loader::offer>);
+	void sort_providers ();
+	void add_catalog ();
+	void begin_graph ();
+	void end_graph ();
 	void create_graph ();
-	void check_graph ();
-	void topological_sort ();
+	optional<unfulfilled_error::entry> check_fulfilled (std::size_t) const;
+	void check_graph (unfulfilled_error::entries_type &);
+	not_a_dag_error::cycle_type get_cycle (const std::vector<std::size_t> &, std::vector<std::size_t> &);
+	void topological_sort (not_a_dag_error::cycles_type &);
+	void record_graph ();
+	void record_critical_path ();
+	void record_profile ();
+	bool verify_plan () const;
+	bool apply_plan ();
+	std::vector<construction_profile::duration::rep> ranks () const;
+	void create_concurrently ();
 	void create ();
 public:
 	dag_resolver () = delete;
@@ -104,6 +212,41 @@ public:
 	 *		events emitted by the newly-created object.
 	 */
 	dag_resolver (offer_factory & of, resolver_observer & ro);
+	/**
+	 *	Creates a dag_resolver which obtains \ref offer
+	 *	objects from an \ref offer_catalog rather than an
+	 *	\ref offer_factory.
+	 *
+	 *	The \ref offer_catalog is never modified and the
+	 *	order in which its providers are considered is
+	 *	reused rather than recomputed.  Accordingly any
+	 *	number of dag_resolver objects may share a single
+	 *	\ref offer_catalog and be used concurrently.
+	 *
+	 *	\param [in] catalog
+	 *		The \ref offer_catalog.  Must outlive the
+	 *		newly-created object.
+	 *	\param [in] ro
+	 *		An optional pointer to a \ref resolver_observer
+	 *		which shall receive events emitted by the
+	 *		newly-created object.  If \em nullptr no
+	 *		\ref resolver_observer will receive these events.
+	 *		Defaults to \em nullptr.
+	 */
+	explicit dag_resolver (const offer_catalog & catalog, resolver_observer * ro = nullptr);
+	/**
+	 *	Creates a dag_resolver which obtains \ref offer
+	 *	objects from an \ref offer_catalog rather than an
+	 *	\ref offer_factory.
+	 *
+	 *	\param [in] catalog
+	 *		The \ref offer_catalog.  Must outlive the
+	 *		newly-created object.
+	 *	\param [in] ro
+	 *		A \ref resolver_observer which shall receive
+	 *		events emitted by the newly-created object.
+	 */
+	dag_resolver (const offer_catalog & catalog, resolver_observer & ro);
 	/**
 	 *	Destroys all managed objects.
 	 *
@@ -116,8 +259,145 @@ public:
 	 *	\ref offer_factory to form a dependency graph
 	 *	and then attempts to resolve this dependency
 	 *	graph by topologically sorting it.
+	 *
+	 *	\ref offer objects pulled by previous calls to
+	 *	this function or to \ref try_resolve are retained
+	 *	and form part of the dependency graph.
 	 */
 	void resolve ();
+	/**
+	 *	Pulls \ref offer objects from the associated
+	 *	\ref offer_factory to form a dependency graph and
+	 *	determines whether that graph could be resolved
+	 *	without constructing any objects or throwing.
+	 *
+	 *	Objects managed as the result of a previous call
+	 *	to \ref resolve are unaffected.  \ref offer objects
+	 *	are retained so that \ref resolve may be invoked
+	 *	subsequently.
+	 *
+	 *	\return
+	 *		A \ref result which describes all unfulfilled
+	 *		requests and cycles.
+	 */
+	result try_resolve ();
+	/**
+	 *	Retrieves a \ref resolution_plan which records
+	 *	how the dependency graph was resolved by the most
+	 *	recent call to \ref resolve.
+	 *
+	 *	Only meaningful while the objects created by that
+	 *	call to \ref resolve exist.  If they do not throws
+	 *	std::logic_error.
+	 *
+	 *	\return
+	 *		A \ref resolution_plan.
+	 */
+	resolution_plan plan () const;
+	/**
+	 *	Provides a \ref resolution_plan which subsequent
+	 *	calls to \ref resolve shall use in place of
+	 *	resolving the dependency graph.
+	 *
+	 *	Before it is used the plan is checked against the
+	 *	\ref offer objects which have been obtained.  If it
+	 *	does not match it is discarded and the dependency
+	 *	graph is resolved as usual.
+	 *
+	 *	\param [in] p
+	 *		The \ref resolution_plan.
+	 */
+	void plan (resolution_plan p);
+	/**
+	 *	Determines whether the most recent call to
+	 *	\ref resolve used a \ref resolution_plan.
+	 *
+	 *	\return
+	 *		\em true if it did, \em false otherwise.
+	 */
+	bool planned () const noexcept;
+	/**
+	 *	Sets the \ref resolver_statistics to which
+	 *	statistics about each subsequent resolution
+	 *	shall be recorded.
+	 *
+	 *	\param [in] s
+	 *		A pointer to the \ref resolver_statistics.  If
+	 *		\em nullptr (the default) no statistics are
+	 *		recorded.
+	 */
+	void statistics (resolver_statistics * s) noexcept;
+	/**
+	 *	Retrieves the \ref resolver_statistics to which
+	 *	statistics are recorded.
+	 *
+	 *	\return
+	 *		A pointer to the \ref resolver_statistics or
+	 *		\em nullptr if statistics are not recorded.
+	 */
+	resolver_statistics * statistics () const noexcept;
+	/**
+	 *	Sets the number of threads which shall construct
+	 *	objects during subsequent calls to \ref resolve.
+	 *
+	 *	When greater than one each object is constructed
+	 *	as soon as all the objects it requests have been
+	 *	constructed, by the calling thread or by one of
+	 *	the threads launched for the purpose.  Of the
+	 *	objects which are ready those on the longest
+	 *	remaining path through the dependency graph are
+	 *	constructed first.  The length of each path is
+	 *	estimated from the durations in the associated
+	 *	\ref construction_profile, if any.
+	 *
+	 *	Every \ref offer must then tolerate being fulfilled
+	 *	on a thread other than that which invoked
+	 *	\ref resolve.  Events are delivered to the
+	 *	\ref resolver_observer one at a time but those
+	 *	concerning different objects may interleave (so
+	 *	for example \ref memory_usage_observer cannot
+	 *	attribute heap usage to objects whose creation
+	 *	overlaps).
+	 *	Objects are still destroyed in the reverse of the
+	 *	order in which they were constructed.
+	 *
+	 *	\param [in] n
+	 *		The number of threads.  Defaults to one, i.e.
+	 *		objects are constructed one at a time by the
+	 *		thread which invokes \ref resolve.  Zero is
+	 *		treated as one.
+	 */
+	void concurrency (std::size_t n) noexcept;
+	/**
+	 *	Retrieves the number of threads which construct
+	 *	objects.
+	 *
+	 *	\return
+	 *		The number of threads.
+	 */
+	std::size_t concurrency () const noexcept;
+	/**
+	 *	Sets the \ref construction_profile which shall be
+	 *	used to prioritize the construction of objects
+	 *	(see \ref concurrency) and to which the time taken
+	 *	to fulfill each \ref offer shall be recorded by
+	 *	each subsequent call to \ref resolve.
+	 *
+	 *	\param [in] p
+	 *		A pointer to the \ref construction_profile.  If
+	 *		\em nullptr (the default) every \ref offer is
+	 *		assumed to take the same time to fulfill and
+	 *		nothing is recorded.
+	 */
+	void profile (construction_profile * p) noexcept;
+	/**
+	 *	Retrieves the associated \ref construction_profile.
+	 *
+	 *	\return
+	 *		A pointer to the \ref construction_profile or
+	 *		\em nullptr if there is none.
+	 */
+	construction_profile * profile () const noexcept;
 };
 
 }
@@ -6,10 +6,12 @@
 
 #include "directory_entry_filter.hpp"
 #include "directory_scanning_shared_library_factory_observer.hpp"
+#include "load_policy.hpp"
 #include "optional.hpp"
 #include "shared_library_factory.hpp"
 #include <boost/dll/shared_library.hpp>
 #include <boost/filesystem.hpp>
+#include <chrono>
 #include <set>
 
 namespace module_loader {
@@ -29,12 +31,13 @@ private:
 	optional<paths_type::const_iterator> path_;
 	directory_entry_filter * filter_;
 	directory_scanning_shared_library_factory_observer * o_;
+	load_policy policy_;
 	bool next_path ();
 	bool next_entry ();
 	bool next_library ();
 	void dispatch_begin_directory () const;
 	void dispatch_end_directory () const;
-	void dispatch_load (const boost::dll::shared_library &) const;
+	void dispatch_load (const boost::dll::shared_library &, std::chrono::steady_clock::duration) const;
 public:
 	/**
 	 *	Creates a directory_scanning_shared_library_factory which
@@ -89,6 +92,23 @@ public:
 	 *		otherwise.
 	 */
 	bool add (boost::filesystem::path path);
+	/**
+	 *	Sets the \ref load_policy according to which
+	 *	shared libraries are opened.  Affects only those
+	 *	shared libraries opened subsequently.
+	 *
+	 *	\param [in] policy
+	 *		The \ref load_policy.
+	 */
+	void policy (load_policy policy) noexcept;
+	/**
+	 *	Retrieves the \ref load_policy according to
+	 *	which shared libraries are opened.
+	 *
+	 *	\return
+	 *		The \ref load_policy.
+	 */
+	const load_policy & policy () const noexcept;
 };
 
 }
@@ -6,6 +6,7 @@
 
 #include <boost/dll/shared_library.hpp>
 #include <boost/filesystem.hpp>
+#include <chrono>
 
 namespace module_loader {
 
@@ -84,6 +85,7 @@ public:
 	class load_event {
 	private:
 		boost::dll::shared_library so_;
+		std::chrono::steady_clock::duration duration_;
 	public:
 		load_event () = delete;
 		load_event (const load_event &) = default;
@@ -91,6 +93,15 @@ public:
 		load_event & operator = (const load_event &) = default;
 		load_event & operator = (load_event &&) = default;
 		explicit load_event (boost::dll::shared_library);
+		/**
+		 *	Creates a load_event.
+		 *
+		 *	\param [in] so
+		 *		The shared library which was loaded.
+		 *	\param [in] duration
+		 *		How long opening the shared library took.
+		 */
+		load_event (boost::dll::shared_library so, std::chrono::steady_clock::duration duration);
 		/**
 		 *	Retrieves a boost::dll::shared_library object
 		 *	which represents the shared library which is the
@@ -100,6 +111,15 @@ public:
 		 *		A boost::dll::shared_library.
 		 */
 		const boost::dll::shared_library & shared_library () const noexcept;
+		/**
+		 *	Retrieves how long opening the shared library
+		 *	took.
+		 *
+		 *	\return
+		 *		A duration which is zero if the time was
+		 *		not measured.
+		 */
+		std::chrono::steady_clock::duration duration () const noexcept;
 	};
 	/**
 	 *	Invoked when a shared library is loaded into
@@ -0,0 +1,151 @@
+/**
+ *	\file
+ */
+
+#pragma once
+
+#include <boost/dll/shared_library.hpp>
+#include <boost/dll/shared_library_load_mode.hpp>
+#include <boost/filesystem.hpp>
+
+namespace module_loader {
+
+/**
+ *	Determines how shared libraries are opened.
+ *
+ *	The default policy is that of boost::dll::shared_library:
+ *	lazy binding with symbols local to the shared library.
+ *	Options which are not supported by the platform are
+ *	ignored.
+ */
+class load_policy {
+public:
+	/**
+	 *	When symbols are bound.
+	 */
+	enum class binding {
+		/**
+		 *	Functions are bound when first called
+		 *	(i.e. RTLD_LAZY), which makes opening
+		 *	shared libraries with many relocations
+		 *	faster.
+		 */
+		lazy,
+		/**
+		 *	All symbols are bound when the shared
+		 *	library is opened (i.e. RTLD_NOW), which
+		 *	surfaces unresolved symbols immediately.
+		 */
+		now
+	};
+	/**
+	 *	Whether the symbols of the shared library
+	 *	are available to resolve the symbols of
+	 *	shared libraries opened subsequently.
+	 */
+	enum class visibility {
+		/**
+		 *	They are not (i.e. RTLD_LOCAL).
+		 */
+		local,
+		/**
+		 *	They are (i.e. RTLD_GLOBAL).
+		 */
+		global
+	};
+private:
+	binding binding_;
+	visibility visibility_;
+	bool deep_bind_;
+	bool no_delete_;
+public:
+	/**
+	 *	Creates the default load_policy.
+	 */
+	load_policy () noexcept;
+	/**
+	 *	Sets when symbols are bound.
+	 *
+	 *	\param [in] b
+	 *		A \ref binding.
+	 */
+	void bind (binding b) noexcept;
+	/**
+	 *	Determines when symbols are bound.
+	 *
+	 *	\return
+	 *		A \ref binding.
+	 */
+	binding bind () const noexcept;
+	/**
+	 *	Sets the visibility of symbols.
+	 *
+	 *	\param [in] v
+	 *		A \ref visibility.
+	 */
+	void symbols (visibility v) noexcept;
+	/**
+	 *	Determines the visibility of symbols.
+	 *
+	 *	\return
+	 *		A \ref visibility.
+	 */
+	visibility symbols () const noexcept;
+	/**
+	 *	Sets whether the shared library prefers its
+	 *	own symbols to global symbols of the same name
+	 *	(i.e. RTLD_DEEPBIND).
+	 *
+	 *	\param [in] deep_bind
+	 *		\em true if it does, \em false otherwise.
+	 */
+	void deep_bind (bool deep_bind) noexcept;
+	/**
+	 *	Determines whether the shared library prefers
+	 *	its own symbols.
+	 *
+	 *	\return
+	 *		\em true if it does, \em false otherwise.
+	 */
+	bool deep_bind () const noexcept;
+	/**
+	 *	Sets whether the shared library remains mapped
+	 *	after it is closed (i.e. RTLD_NODELETE) so that
+	 *	reopening it is cheap and pointers into it remain
+	 *	valid.
+	 *
+	 *	\param [in] no_delete
+	 *		\em true if it does, \em false otherwise.
+	 */
+	void no_delete (bool no_delete) noexcept;
+	/**
+	 *	Determines whether the shared library remains
+	 *	mapped after it is closed.
+	 *
+	 *	\return
+	 *		\em true if it does, \em false otherwise.
+	 */
+	bool no_delete () const noexcept;
+	/**
+	 *	Determines the mode with which a
+	 *	boost::dll::shared_library should be opened
+	 *	to implement this policy.
+	 *
+	 *	\return
+	 *		A boost::dll::load_mode::type.
+	 */
+	boost::dll::load_mode::type mode () const noexcept;
+	/**
+	 *	Opens a shared library according to this
+	 *	policy.
+	 *
+	 *	\param [in] path
+	 *		The path to the shared library.
+	 *
+	 *	\return
+	 *		A boost::dll::shared_library.
+	 */
+	boost::dll::shared_library load (const boost::filesystem::path & path) const;
+};
+
+}
@@ -0,0 +1,188 @@
+/**
+ *	\file
+ */
+
+#pragma once
+
+#include "object.hpp"
+#include "resolver_observer.hpp"
+#include "shared_library_offer_factory_observer.hpp"
+#include <boost/dll/shared_library.hpp>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace module_loader {
+
+/**
+ *	Attributes memory usage to the \ref object
+ *	instances created by a resolver and to the
+ *	shared libraries loaded by a
+ *	\ref shared_library_offer_factory.
+ *
+ *	Heap usage is measured as the change in the
+ *	number of bytes the allocator reports as in use
+ *	between the beginning and end of each creation
+ *	or load.  Since this figure is process wide the
+ *	attribution is only accurate if no other thread
+ *	allocates or deallocates meanwhile.  Where the
+ *	allocator cannot report this figure heap usage
+ *	is always zero.
+ *
+ *	For the same reason objects whose creation
+ *	overlapped that of another object on another
+ *	thread (see \ref dag_resolver::concurrency) are
+ *	not charged for any heap:  The change in the
+ *	process wide figure cannot be divided between
+ *	them.
+ *
+ *	Shared libraries are additionally charged for the
+ *	size of the segments mapped when they were loaded.
+ *	Heap usage is not attributed to shared libraries
+ *	whose load handlers are invoked concurrently (see
+ *	\ref shared_library_offer_factory::concurrency)
+ *	since their events are dispatched after the fact.
+ */
+class memory_usage_observer : public resolver_observer, public shared_library_offer_factory_observer {
+public:
+	/**
+	 *	Describes the memory attributed to a single
+	 *	\ref object or shared library.
+	 */
+	class entry {
+	private:
+		std::string name_;
+		std::size_t heap_;
+		std::size_t mapped_;
+	public:
+		entry () = delete;
+		entry (const entry &) = default;
+		entry (entry &&) = default;
+		entry & operator = (const entry &) = default;
+		entry & operator = (entry &&) = default;
+		/**
+		 *	Creates an entry.
+		 *
+		 *	\param [in] name
+		 *		The name of the \ref object or the path
+		 *		of the shared library.
+		 *	\param [in] heap
+		 *		The number of bytes of heap.
+		 *	\param [in] mapped
+		 *		The number of bytes mapped.
+		 */
+		entry (std::string name, std::size_t heap, std::size_t mapped) noexcept;
+		/**
+		 *	Retrieves the name of the \ref object or the
+		 *	path of the shared library.
+		 *
+		 *	\return
+		 *		A string.
+		 */
+		const std::string & name () const noexcept;
+		/**
+		 *	Retrieves the number of bytes of heap.
+		 *
+		 *	\return
+		 *		The number of bytes.
+		 */
+		std::size_t heap () const noexcept;
+		/**
+		 *	Retrieves the number of bytes mapped.  Always
+		 *	zero for \ref object instances.
+		 *
+		 *	\return
+		 *		The number of bytes.
+		 */
+		std::size_t mapped () const noexcept;
+		/**
+		 *	Retrieves the total number of bytes.
+		 *
+		 *	\return
+		 *		The sum of \ref heap and \ref mapped.
+		 */
+		std::size_t total () const noexcept;
+	};
+	/**
+	 *	A collection of \ref entry objects sorted
+	 *	from largest to smallest.
+	 */
+	using entries_type = std::vector<entry>;
+private:
+	class pending_create {
+	public:
+		std::string name;
+		std::size_t begin;
+		std::thread::id thread;
+		bool overlapped;
+	};
+	std::unordered_map<const offer *,pending_create> creating_;
+	std::size_t load_begin_;
+	std::unordered_map<const object *,entry> objects_;
+	std::unordered_map<std::string,entry> libraries_;
+	template <typename Map>
+	static entries_type sorted (const Map &);
+public:
+	/**
+	 *	Creates a new memory_usage_observer.
+	 */
+	memory_usage_observer ();
+	virtual void on_resolve (resolve_event) override;
+	virtual void on_begin_create (begin_create_event) override;
+	virtual void on_create (create_event) override;
+	virtual void on_destroy (destroy_event) override;
+	virtual void on_begin_load (begin_load_event) override;
+	virtual void on_end_load (end_load_event) override;
+	virtual void on_add (add_event) override;
+	/**
+	 *	Retrieves the memory attributed to each
+	 *	\ref object which has been created but not
+	 *	yet destroyed.
+	 *
+	 *	\return
+	 *		An \ref entries_type.
+	 */
+	entries_type objects () const;
+	/**
+	 *	Retrieves the memory attributed to each
+	 *	shared library which has been loaded.
+	 *
+	 *	\return
+	 *		An \ref entries_type.
+	 */
+	entries_type libraries () const;
+	/**
+	 *	Writes a human readable report of \ref objects
+	 *	and \ref libraries.
+	 *
+	 *	\param [in] os
+	 *		The stream to which to write.
+	 */
+	void report (std::ostream & os) const;
+	/**
+	 *	Determines the number of bytes of heap which
+	 *	are currently in use by the process.
+	 *
+	 *	\return
+	 *		The number of bytes, or zero if this cannot
+	 *		be determined.
+	 */
+	static std::size_t heap_in_use () noexcept;
+	/**
+	 *	Determines the number of bytes mapped by the
+	 *	loadable segments of a shared library.
+	 *
+	 *	\param [in] so
+	 *		The shared library.
+	 *
+	 *	\return
+	 *		The number of bytes, or zero if this cannot
+	 *		be determined.
+	 */
+	static std::size_t mapped_size (const boost::dll::shared_library & so) noexcept;
+};
+
+}
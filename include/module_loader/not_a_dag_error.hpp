@@ -7,6 +7,7 @@
 #include "offer.hpp"
 #include "resolver_error.hpp"
 #include <memory>
+#include <ostream>
 #include <vector>
 
 namespace module_loader {
@@ -15,6 +16,9 @@ namespace module_loader {
  *	Thrown by \ref dag_resolver when it
  *	encounters a dependency graph which is
  *	not a directed acyclic graph (i.e. DAG).
+ *
+ *	The message returned by \ref what is only
+ *	generated when first requested.
  */
 class not_a_dag_error : public resolver_error {
 public:
@@ -29,6 +33,8 @@ public:
 	using cycles_type = std::vector<cycle_type>;
 private:
 	cycles_type cycles_;
+protected:
+	virtual void format (std::ostream &) const override;
 public:
 	not_a_dag_error () = delete;
 	not_a_dag_error (const not_a_dag_error &) = default;
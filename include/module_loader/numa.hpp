@@ -0,0 +1,57 @@
+/**
+ *	\file
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace module_loader {
+
+/**
+ *	Determines which NUMA nodes are online.
+ *
+ *	\return
+ *		The indices of the NUMA nodes in ascending order.
+ *		If the topology cannot be determined (e.g. on
+ *		platforms other than Linux) a single node, node 0,
+ *		is assumed.
+ */
+std::vector<std::size_t> numa_nodes ();
+
+/**
+ *	Determines which CPUs belong to a certain NUMA node.
+ *
+ *	\param [in] node
+ *		The index of the NUMA node.
+ *
+ *	\return
+ *		The indices of the CPUs in ascending order.  Empty
+ *		if the node does not exist or the topology cannot
+ *		be determined.
+ */
+std::vector<std::size_t> numa_cpus (std::size_t node);
+
+/**
+ *	Invokes a function on a thread bound to the CPUs of
+ *	a certain NUMA node and waits for it to return.
+ *
+ *	Under a first touch policy memory which the function
+ *	allocates and initializes is thereby placed on that
+ *	node.
+ *
+ *	If the CPUs of the node cannot be determined, or the
+ *	thread cannot be bound thereto, the function is
+ *	invoked on the calling thread.
+ *
+ *	\param [in] node
+ *		The index of the NUMA node.
+ *	\param [in] func
+ *		The function.  Any exception it throws is thrown
+ *		on the calling thread.
+ */
+void run_on_numa_node (std::size_t node, const std::function<void ()> & func);
+
+}
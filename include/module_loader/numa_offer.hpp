@@ -0,0 +1,87 @@
+/**
+ *	\file
+ */
+
+#pragma once
+
+#include "numa.hpp"
+#include "object.hpp"
+#include "offer.hpp"
+#include "offer_decorator.hpp"
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace module_loader {
+
+/**
+ *	Decorates an \ref offer such that it is fulfilled
+ *	on a thread bound to a certain NUMA node.
+ *
+ *	Objects which are allocated and initialized when
+ *	the \ref offer is fulfilled are thereby placed on
+ *	that node (assuming a first touch policy), rather
+ *	than on whichever node the thread which resolves the
+ *	dependency graph happens to be running on.
+ *
+ *	\tparam Pointer
+ *		The smart pointer which shall be used to manage
+ *		the lifetime of the inner \ref offer.
+ */
+template <typename Pointer>
+class numa_offer : public offer_decorator<Pointer> {
+private:
+	using base = offer_decorator<Pointer>;
+	std::size_t node_;
+public:
+	using fulfill_type = typename base::fulfill_type;
+	/**
+	 *	Creates a numa_offer.
+	 *
+	 *	\param [in] inner
+	 *		A smart pointer to the \ref offer which shall
+	 *		be wrapped.
+	 *	\param [in] node
+	 *		The index of the NUMA node.
+	 */
+	numa_offer (Pointer inner, std::size_t node) noexcept(std::is_nothrow_constructible<base,Pointer>::value)
+		:	base(std::move(inner)),
+			node_(node)
+	{	}
+	virtual std::unique_ptr<object> fulfill (const fulfill_type & objects) override {
+		std::unique_ptr<object> retr;
+		run_on_numa_node(node_,[&] () {	retr = base::fulfill(objects);	});
+		return retr;
+	}
+	virtual std::shared_ptr<object> fulfill_shared (const fulfill_type & objects) override {
+		std::shared_ptr<object> retr;
+		run_on_numa_node(node_,[&] () {	retr = base::fulfill_shared(objects);	});
+		return retr;
+	}
+	/**
+	 *	Retrieves the index of the NUMA node.
+	 *
+	 *	\return
+	 *		The index.
+	 */
+	std::size_t node () const noexcept {
+		return node_;
+	}
+};
+
+/**
+ *	A helper function which creates a \ref numa_offer.
+ *
+ *	\param [in] inner
+ *		The \ref offer to wrap.
+ *	\param [in] node
+ *		The index of the NUMA node.
+ *
+ *	\return
+ *		A smart pointer to an \ref offer.
+ */
+std::unique_ptr<offer> make_numa_offer (std::unique_ptr<offer> inner, std::size_t node);
+std::shared_ptr<offer> make_numa_offer (std::shared_ptr<offer> inner, std::size_t node);
+
+}
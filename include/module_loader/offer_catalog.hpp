@@ -0,0 +1,81 @@
+/**
+ *	\file
+ */
+
+#pragma once
+
+#include "offer.hpp"
+#include "offer_factory.hpp"
+#include <cstddef>
+#include <memory>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace module_loader {
+
+/**
+ *	An immutable snapshot of all the \ref offer
+ *	objects yielded by an \ref offer_factory.
+ *
+ *	Once created an offer_catalog is never modified
+ *	and therefore any number of threads may read it
+ *	concurrently.  In particular any number of
+ *	\ref dag_resolver objects may be created from a
+ *	single offer_catalog and used concurrently on
+ *	different threads, each building its own set of
+ *	objects from the same \ref offer objects.
+ *
+ *	Since each \ref offer may therefore be fulfilled
+ *	by several threads at once \ref offer objects
+ *	placed in an offer_catalog which is shared between
+ *	threads must tolerate this.
+ */
+class offer_catalog {
+public:
+	/**
+	 *	The type of the collection of \ref offer objects.
+	 */
+	using offers_type = std::vector<std::shared_ptr<offer>>;
+	/**
+	 *	Maps each provided type to the indices within
+	 *	\ref offers_type of the \ref offer objects which
+	 *	provide it.  The indices for each type are in the
+	 *	order in which a resolver considers the providers.
+	 */
+	using providers_type = std::unordered_map<std::type_index,std::vector<std::size_t>>;
+private:
+	offers_type offers_;
+	providers_type providers_;
+public:
+	offer_catalog () = delete;
+	offer_catalog (const offer_catalog &) = delete;
+	offer_catalog (offer_catalog &&) = delete;
+	offer_catalog & operator = (const offer_catalog &) = delete;
+	offer_catalog & operator = (offer_catalog &&) = delete;
+	/**
+	 *	Creates an offer_catalog by retrieving all
+	 *	\ref offer objects from an \ref offer_factory.
+	 *
+	 *	\param [in] of
+	 *		The \ref offer_factory.
+	 */
+	explicit offer_catalog (offer_factory & of);
+	/**
+	 *	Retrieves all \ref offer objects in the order
+	 *	in which they were yielded.
+	 *
+	 *	\return
+	 *		An \ref offers_type.
+	 */
+	const offers_type & offers () const noexcept;
+	/**
+	 *	Retrieves the providers of each type.
+	 *
+	 *	\return
+	 *		A \ref providers_type.
+	 */
+	const providers_type & providers () const noexcept;
+};
+
+}
@@ -5,7 +5,9 @@
 #pragma once
 
 #include "offer.hpp"
+#include <cstddef>
 #include <memory>
+#include <vector>
 
 namespace module_loader {
 
@@ -15,6 +17,11 @@ namespace module_loader {
  */
 class offer_factory {
 public:
+	/**
+	 *	A collection of \ref offer objects retrieved
+	 *	by \ref next_batch.
+	 */
+	using batch_type = std::vector<std::shared_ptr<offer>>;
 	offer_factory () = default;
 	offer_factory (const offer_factory &) = delete;
 	offer_factory (offer_factory &&) = delete;
@@ -35,6 +42,43 @@ public:
 	 */
 	virtual std::unique_ptr<offer> next () = 0;
 	virtual std::shared_ptr<offer> next_shared () = 0;
+	/**
+	 *	Retrieves up to a certain number of the next
+	 *	\ref offer objects in the sequence.
+	 *
+	 *	The default implementation simply invokes
+	 *	\ref next_shared repeatedly.  Derived classes
+	 *	may override it to amortize the cost of
+	 *	retrieval across many \ref offer objects.
+	 *
+	 *	\param [in] batch
+	 *		A collection to which the retrieved \ref offer
+	 *		objects shall be appended.  Elements already
+	 *		in the collection are not modified.
+	 *	\param [in] max
+	 *		The maximum number of \ref offer objects to
+	 *		retrieve.
+	 *
+	 *	\return
+	 *		The number of \ref offer objects appended to
+	 *		\em batch.  If this is less than \em max
+	 *		(including 0) the sequence has been exhausted
+	 *		unless \em max is 0.
+	 */
+	virtual std::size_t next_batch (batch_type & batch, std::size_t max);
+	/**
+	 *	Estimates the number of \ref offer objects which
+	 *	remain in the sequence so that consumers may
+	 *	allocate storage for them all at once.
+	 *
+	 *	The estimate need not be exact and consumers shall
+	 *	not rely upon it for correctness.  The default
+	 *	implementation returns 0, i.e. no estimate.
+	 *
+	 *	\return
+	 *		The estimated number of \ref offer objects.
+	 */
+	virtual std::size_t size_hint () const noexcept;
 };
 
 }
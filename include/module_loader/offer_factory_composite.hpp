@@ -6,6 +6,7 @@
 
 #include "offer.hpp"
 #include "offer_factory.hpp"
+#include <cstddef>
 #include <deque>
 #include <memory>
 
@@ -35,6 +36,15 @@ public:
 	void add (offer_factory & factory);
 	virtual std::unique_ptr<offer> next () override;
 	virtual std::shared_ptr<offer> next_shared () override;
+	virtual std::size_t next_batch (batch_type & batch, std::size_t max) override;
+	/**
+	 *	Returns the sum of the estimates of the remaining
+	 *	\ref offer_factory objects.
+	 *
+	 *	\return
+	 *		The estimated number of \ref offer objects.
+	 */
+	virtual std::size_t size_hint () const noexcept override;
 };
 
 }
@@ -0,0 +1,223 @@
+/**
+ *	\file
+ */
+
+#pragma once
+
+#include <boost/filesystem.hpp>
+#include <cstddef>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ *	The name of the section into which
+ *	\ref MODULE_LOADER_OFFER_METADATA places records.
+ */
+#define MODULE_LOADER_OFFER_METADATA_SECTION "module_loader_offers"
+
+#if defined(__ELF__)
+#define MODULE_LOADER_OFFER_METADATA_ATTRIBUTES __attribute__((section(MODULE_LOADER_OFFER_METADATA_SECTION),used))
+#else
+#define MODULE_LOADER_OFFER_METADATA_ATTRIBUTES
+#endif
+
+/**
+ *	Describes an \ref module_loader::offer "offer" which a
+ *	shared library adds from its load handler so that it
+ *	may be discovered by \ref module_loader::read_offer_metadata
+ *	without loading the shared library.
+ *
+ *	The record is a constant placed in a dedicated section
+ *	and therefore requires neither relocations nor static
+ *	initialization.  On platforms other than ELF the record
+ *	is emitted but cannot be discovered.
+ *
+ *	Types are recorded as spelled since no name for a
+ *	type may be obtained at compile time.  When read
+ *	the spelling is normalized so that whitespace and
+ *	leading global scope qualifiers do not matter (e.g.
+ *	\em std::map<int, int> and \em ::std::map<int,int>
+ *	match) but each type must otherwise be spelled
+ *	identically everywhere it appears (preferably fully
+ *	qualified, and with the same template arguments
+ *	given explicitly) for providers and requests to
+ *	match.
+ *
+ *	Each requested type is taken to be requested exactly
+ *	once, as by \ref module_loader::variadic_offer "variadic_offer".
+ *	See \ref MODULE_LOADER_BOUNDED_OFFER_METADATA for other
+ *	bounds.
+ *
+ *	\param id
+ *		An identifier unique within the translation unit.
+ *	\param name
+ *		A string literal giving the name of the offer.
+ *	\param provides
+ *		The type the offer provides or a parenthesized
+ *		list of types.  Since bases cannot be discovered
+ *		from the record any base by which the object may
+ *		be requested must be listed, e.g. \em (derived, base).
+ *	\param ...
+ *		The types the offer requests, if any.
+ */
+#define MODULE_LOADER_OFFER_METADATA(id,name,provides,...) \
+	MODULE_LOADER_BOUNDED_OFFER_METADATA(id,name,provides,(),__VA_ARGS__)
+
+/**
+ *	As \ref MODULE_LOADER_OFFER_METADATA but additionally
+ *	records the bounds of each request.
+ *
+ *	\param id
+ *		An identifier unique within the translation unit.
+ *	\param name
+ *		A string literal giving the name of the offer.
+ *	\param provides
+ *		The type the offer provides or a parenthesized
+ *		list of types.
+ *	\param bounds
+ *		A parenthesized list giving the lower and upper
+ *		bounds of each request in order, each in the form
+ *		\em lower:upper where an upper bound of \em * is
+ *		unbounded, e.g. \em (1:1, 0:*).  \em () requests
+ *		each type exactly once.
+ *	\param ...
+ *		The types the offer requests, if any.
+ */
+#define MODULE_LOADER_BOUNDED_OFFER_METADATA(id,name,provides,bounds,...) \
+	MODULE_LOADER_OFFER_METADATA_ATTRIBUTES \
+	static const char module_loader_offer_metadata_ ## id [] = "\x02" name "\0" #provides "\0" #__VA_ARGS__ "\0" #bounds
+
+namespace module_loader {
+
+/**
+ *	Describes an offer as recorded by
+ *	\ref MODULE_LOADER_OFFER_METADATA.
+ */
+class offer_metadata {
+public:
+	/**
+	 *	The type of the collection of provided types.
+	 */
+	using provides_type = std::vector<std::string>;
+	/**
+	 *	The type of the collection of requested types.
+	 */
+	using requests_type = std::vector<std::string>;
+	/**
+	 *	The type of the collection of the lower and
+	 *	upper bounds of each request.
+	 */
+	using bounds_type = std::vector<std::pair<std::size_t,std::size_t>>;
+private:
+	std::string name_;
+	provides_type provides_;
+	requests_type requests_;
+	bounds_type bounds_;
+public:
+	offer_metadata () = delete;
+	offer_metadata (const offer_metadata &) = default;
+	offer_metadata (offer_metadata &&) = default;
+	offer_metadata & operator = (const offer_metadata &) = default;
+	offer_metadata & operator = (offer_metadata &&) = default;
+	/**
+	 *	Creates an offer_metadata.
+	 *
+	 *	\param [in] name
+	 *		The name of the offer.
+	 *	\param [in] provides
+	 *		The types provided.
+	 *	\param [in] requests
+	 *		The types requested.
+	 *	\param [in] bounds
+	 *		The bounds of each request.  If empty each
+	 *		type is requested exactly once.  Otherwise
+	 *		shall have one element per request.
+	 */
+	offer_metadata (std::string name, provides_type provides, requests_type requests, bounds_type bounds = bounds_type{});
+	/**
+	 *	Retrieves the name of the offer.
+	 *
+	 *	\return
+	 *		A string.
+	 */
+	const std::string & name () const noexcept;
+	/**
+	 *	Retrieves the types the offer provides as
+	 *	spelled.
+	 *
+	 *	\return
+	 *		A \ref provides_type.
+	 */
+	const provides_type & provides () const noexcept;
+	/**
+	 *	Retrieves the types the offer requests as
+	 *	spelled.
+	 *
+	 *	\return
+	 *		A \ref requests_type.
+	 */
+	const requests_type & requests () const noexcept;
+	/**
+	 *	Retrieves the bounds of each request.
+	 *
+	 *	\return
+	 *		A \ref bounds_type with one element per
+	 *		request.
+	 */
+	const bounds_type & bounds () const noexcept;
+};
+
+/**
+ *	Reads the records placed in a shared library by
+ *	\ref MODULE_LOADER_OFFER_METADATA.
+ *
+ *	The shared library is mapped read only and its
+ *	section headers inspected, it is not loaded and
+ *	none of its code is run.
+ *
+ *	\param [in] path
+ *		The path to the shared library.
+ *
+ *	\return
+ *		The records in the order in which they appear
+ *		with the spelling of each type normalized.
+ *		Empty if the shared library contains no records
+ *		or is not in a format which may be inspected.
+ *		Throws \ref error if the file cannot be read or
+ *		is a malformed ELF file.
+ */
+std::vector<offer_metadata> read_offer_metadata (const boost::filesystem::path & path);
+
+/**
+ *	Associates shared libraries with the records
+ *	read from them.
+ */
+using library_metadata = std::map<boost::filesystem::path,std::vector<offer_metadata>>;
+
+/**
+ *	Determines which shared libraries must be loaded
+ *	in order to fulfill a set of requests.
+ *
+ *	Every shared library containing an offer of a type
+ *	which is requested, whether directly or by an offer
+ *	in another shared library which is itself required,
+ *	is required.  Requests whose lower bound is zero do
+ *	not make shared libraries required.
+ *
+ *	\param [in] libraries
+ *		The shared libraries and their records.
+ *	\param [in] requests
+ *		The types requested, spelled as in the records
+ *		(the spelling is normalized as the records'
+ *		are).
+ *
+ *	\return
+ *		The paths of the shared libraries which are
+ *		required.
+ */
+std::set<boost::filesystem::path> required_libraries (const library_metadata & libraries, const std::vector<std::string> & requests);
+
+}
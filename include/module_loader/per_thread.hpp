@@ -0,0 +1,178 @@
+/**
+ *	\file
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace module_loader {
+
+/**
+ *	Holds one replica of an object for each thread
+ *	which accesses it.
+ *
+ *	Each thread's replica is constructed the first
+ *	time that thread accesses it.  Subsequent accesses
+ *	from that thread are satisfied from a small thread
+ *	local cache, keyed by per_thread object, without
+ *	synchronization.  A thread which alternates between
+ *	more per_thread objects of the same type than the
+ *	cache has slots may nonetheless miss and fall back
+ *	to a synchronized lookup.
+ *
+ *	Replicas are destroyed, in the reverse order of their
+ *	construction, when the per_thread is destroyed and not
+ *	when the threads exit.  The replicas of threads which
+ *	have exited are therefore retained (and visited by
+ *	\ref for_each) until then, and memory usage grows
+ *	with the number of distinct threads which access the
+ *	per_thread.  Should the implementation reuse the
+ *	identifier of an exited thread the new thread receives
+ *	that thread's replica.  The per_thread must outlive
+ *	any use of the replicas.
+ *
+ *	\tparam T
+ *		The type of object.
+ */
+template <typename T>
+class per_thread {
+public:
+	/**
+	 *	The type of function which constructs replicas.
+	 */
+	using factory_type = std::function<std::unique_ptr<T> ()>;
+private:
+	class slot {
+	public:
+		std::size_t id;
+		T * ptr;
+	};
+	static constexpr std::size_t slots = 8;
+	using cache = std::array<slot,slots>;
+	//	Identifiers are never reused (and zero is never
+	//	issued) so a cache entry cannot be mistaken for that
+	//	of a per_thread which has since been destroyed and
+	//	whose address has been reused
+	static std::size_t next_id () noexcept {
+		static std::atomic<std::size_t> id(1);
+		return id++;
+	}
+	//	Consecutively constructed per_thread objects map
+	//	to distinct slots
+	slot & local () const noexcept {
+		static thread_local cache c{};
+		return c[id_ % slots];
+	}
+	factory_type factory_;
+	std::size_t id_;
+	mutable std::mutex m_;
+	std::unordered_map<std::thread::id,T *> map_;
+	std::vector<std::unique_ptr<T>> replicas_;
+	T & get_slow () {
+		T * ptr;
+		{
+			std::unique_lock<std::mutex> l(m_);
+			auto iter = map_.find(std::this_thread::get_id());
+			if (iter == map_.end()) {
+				l.unlock();
+				//	Construct without holding the lock so that
+				//	constructors may be slow
+				auto replica = factory_();
+				l.lock();
+				ptr = replica.get();
+				replicas_.push_back(std::move(replica));
+				map_.emplace(std::this_thread::get_id(),ptr);
+			} else {
+				ptr = iter->second;
+			}
+		}
+		local() = slot{id_,ptr};
+		return *ptr;
+	}
+public:
+	per_thread () = delete;
+	per_thread (const per_thread &) = delete;
+	per_thread (per_thread &&) = delete;
+	per_thread & operator = (const per_thread &) = delete;
+	per_thread & operator = (per_thread &&) = delete;
+	/**
+	 *	Creates a per_thread.
+	 *
+	 *	\param [in] factory
+	 *		A function which constructs a replica.  It is
+	 *		invoked on the thread for which the replica is
+	 *		being constructed.
+	 */
+	explicit per_thread (factory_type factory)
+		:	factory_(std::move(factory)),
+			id_(next_id())
+	{	}
+	/**
+	 *	Destroys all replicas in the reverse order of
+	 *	their construction.
+	 */
+	~per_thread () noexcept {
+		while (!replicas_.empty()) replicas_.pop_back();
+	}
+	/**
+	 *	Retrieves the replica for the calling thread,
+	 *	constructing it if necessary.
+	 *
+	 *	\return
+	 *		A reference to the replica.
+	 */
+	T & get () {
+		auto && c = local();
+		if (c.id == id_) return *c.ptr;
+		return get_slow();
+	}
+	T & operator * () {
+		return get();
+	}
+	T * operator -> () {
+		return &get();
+	}
+	/**
+	 *	Determines the number of replicas.
+	 *
+	 *	\return
+	 *		The number of threads for which a replica has
+	 *		been constructed.
+	 */
+	std::size_t size () const {
+		std::lock_guard<std::mutex> l(m_);
+		return replicas_.size();
+	}
+	/**
+	 *	Invokes a function for each replica in the order
+	 *	in which they were constructed (e.g. to aggregate
+	 *	per thread statistics).
+	 *
+	 *	Replicas may be in use on other threads while the
+	 *	function is invoked.  Replicas may not be constructed
+	 *	while the function is invoked.
+	 *
+	 *	\param [in] func
+	 *		The function.
+	 */
+	template <typename Func>
+	void for_each (Func && func) {
+		std::lock_guard<std::mutex> l(m_);
+		for (auto && ptr : replicas_) func(*ptr);
+	}
+};
+
+template <typename T>
+constexpr std::size_t per_thread<T>::slots;
+
+}
@@ -0,0 +1,64 @@
+/**
+ *	\file
+ */
+
+#pragma once
+
+#include "in_place_object.hpp"
+#include "object.hpp"
+#include "per_thread.hpp"
+#include "variadic_offer.hpp"
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <utility>
+
+namespace module_loader {
+
+/**
+ *	An offer which generates an \ref in_place_object
+ *	containing a \ref per_thread when fulfilled.
+ *
+ *	Dependents request \ref per_thread "per_thread<T>"
+ *	and obtain one replica of \em T for each thread on
+ *	which they access it.  The replicas are destroyed
+ *	along with the \ref per_thread, i.e. when the
+ *	resolver destroys the objects it created.
+ *
+ *	\tparam T
+ *		The type of object to replicate.
+ *	\tparam Ts
+ *		The types of objects to request.  Exactly one
+ *		instance of each such type shall be requested
+ *		and shall be passed through to a constructor
+ *		of \em T when each replica is constructed.  These
+ *		objects are shared by all replicas.
+ */
+template <typename T, typename... Ts>
+class per_thread_offer : public variadic_offer<per_thread<T>,Ts...> {
+private:
+	using base = variadic_offer<per_thread<T>,Ts...>;
+	using object_type = in_place_object<per_thread<T>>;
+public:
+	using fulfill_type = typename base::fulfill_type;
+private:
+	template <std::size_t... Is>
+	static typename per_thread<T>::factory_type get_factory (const fulfill_type & objects, std::index_sequence<Is...>) {
+		std::tuple<Ts *...> ptrs(static_cast<Ts *>(*objects[Is].first)...);
+		return [ptrs] () {	return std::make_unique<T>(*std::get<Is>(ptrs)...);	};
+	}
+	typename per_thread<T>::factory_type get_factory (const fulfill_type & objects) {
+		base::check_requests(objects);
+		return get_factory(objects,base::index_sequence);
+	}
+public:
+	using base::base;
+	virtual std::unique_ptr<object> fulfill (const fulfill_type & objects) override {
+		return std::make_unique<object_type>(*this,get_factory(objects));
+	}
+	virtual std::shared_ptr<object> fulfill_shared (const fulfill_type & objects) override {
+		return std::make_shared<object_type>(*this,get_factory(objects));
+	}
+};
+
+}
@@ -0,0 +1,189 @@
+/**
+ *	\file
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace module_loader {
+
+/**
+ *	A per-thread free list of fixed size blocks of
+ *	storage.
+ *
+ *	Blocks released on a thread are retained by that
+ *	thread and handed out again by subsequent
+ *	allocations on that thread so that once a
+ *	workload reaches its high water mark it no
+ *	longer touches the global heap.  Since each
+ *	thread has its own list no synchronization is
+ *	required.
+ *
+ *	Blocks may be released on a thread other than
+ *	the one which allocated them, in which case they
+ *	join the releasing thread's list.  Each list holds
+ *	at most \ref capacity blocks, blocks released
+ *	beyond that are returned to the global heap, so a
+ *	thread which only releases blocks (e.g. the consumer
+ *	in a producer/consumer pattern) does not accumulate
+ *	them without bound.  Blocks which remain in a
+ *	thread's list when that thread exits are returned
+ *	to the global heap.
+ *
+ *	\tparam Size
+ *		The size of each block.
+ *	\tparam Align
+ *		The alignment of each block.
+ */
+template <std::size_t Size, std::size_t Align>
+class free_list {
+private:
+	static_assert(Align <= alignof(std::max_align_t),"Over-aligned blocks are not supported");
+	union block {
+		block * next;
+		std::aligned_storage_t<Size,Align> storage;
+	};
+	class reaper {
+	public:
+		reaper () = default;
+		reaper (const reaper &) = delete;
+		reaper (reaper &&) = delete;
+		reaper & operator = (const reaper &) = delete;
+		reaper & operator = (reaper &&) = delete;
+		~reaper () noexcept {
+			while (head_) {
+				auto ptr = head_;
+				head_ = ptr->next;
+				::operator delete(ptr);
+			}
+			count_ = 0;
+			//	Blocks released after this point (e.g.
+			//	from the destructors of other thread local
+			//	objects) go straight back to the heap
+			dead_ = true;
+		}
+	};
+	//	These are trivially destructible so they remain
+	//	usable even after the reaper has run
+	static thread_local block * head_;
+	static thread_local std::size_t count_;
+	static thread_local bool dead_;
+	static void attach () {
+		static thread_local reaper r;
+		(void)r;
+	}
+public:
+	free_list () = delete;
+	/**
+	 *	The size of each block.
+	 */
+	static constexpr std::size_t size = Size;
+	/**
+	 *	The maximum number of blocks retained by each
+	 *	thread's list.
+	 */
+	static constexpr std::size_t capacity = 256;
+	/**
+	 *	Determines the number of blocks in the calling
+	 *	thread's list.
+	 *
+	 *	\return
+	 *		The number of blocks.
+	 */
+	static std::size_t cached () noexcept {
+		return count_;
+	}
+	/**
+	 *	Obtains a block, either from the calling
+	 *	thread's list or from the global heap.
+	 *
+	 *	\return
+	 *		A pointer to at least \em Size bytes of
+	 *		storage aligned to \em Align.
+	 */
+	static void * allocate () {
+		if (head_) {
+			auto retr = head_;
+			head_ = retr->next;
+			--count_;
+			return retr;
+		}
+		return ::operator new(sizeof(block));
+	}
+	/**
+	 *	Returns a block obtained from \ref allocate
+	 *	to the calling thread's list or, if that list is
+	 *	full, to the global heap.
+	 *
+	 *	\param [in] ptr
+	 *		A pointer to the block.
+	 */
+	static void deallocate (void * ptr) noexcept {
+		if (dead_ || (count_ == capacity)) {
+			::operator delete(ptr);
+			return;
+		}
+		attach();
+		auto b = static_cast<block *>(ptr);
+		b->next = head_;
+		head_ = b;
+		++count_;
+	}
+};
+
+template <std::size_t Size, std::size_t Align>
+constexpr std::size_t free_list<Size,Align>::size;
+template <std::size_t Size, std::size_t Align>
+constexpr std::size_t free_list<Size,Align>::capacity;
+template <std::size_t Size, std::size_t Align>
+thread_local typename free_list<Size,Align>::block * free_list<Size,Align>::head_ = nullptr;
+template <std::size_t Size, std::size_t Align>
+thread_local std::size_t free_list<Size,Align>::count_ = 0;
+template <std::size_t Size, std::size_t Align>
+thread_local bool free_list<Size,Align>::dead_ = false;
+
+/**
+ *	A standard allocator which satisfies single object
+ *	allocations from a \ref free_list.
+ *
+ *	Allocations of more than one object are forwarded
+ *	to the global heap.  Suitable for use with
+ *	std::allocate_shared in which case both the object
+ *	and its control block are recycled.
+ *
+ *	\tparam T
+ *		The type of object to allocate.
+ */
+template <typename T>
+class pool_allocator {
+private:
+	using list = free_list<sizeof(T),alignof(T)>;
+public:
+	using value_type = T;
+	pool_allocator () = default;
+	template <typename U>
+	pool_allocator (const pool_allocator<U> &) noexcept {	}
+	T * allocate (std::size_t n) {
+		if (n == 1U) return static_cast<T *>(list::allocate());
+		return static_cast<T *>(::operator new(n * sizeof(T)));
+	}
+	void deallocate (T * ptr, std::size_t n) noexcept {
+		if (n == 1U) list::deallocate(ptr);
+		else ::operator delete(ptr);
+	}
+};
+
+template <typename T, typename U>
+bool operator == (const pool_allocator<T> &, const pool_allocator<U> &) noexcept {
+	return true;
+}
+
+template <typename T, typename U>
+bool operator != (const pool_allocator<T> &, const pool_allocator<U> &) noexcept {
+	return false;
+}
+
+}
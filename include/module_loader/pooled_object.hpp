@@ -0,0 +1,45 @@
+/**
+ *	\file
+ */
+
+#pragma once
+
+#include "in_place_object.hpp"
+#include "pool.hpp"
+#include <cstddef>
+#include <new>
+
+namespace module_loader {
+
+/**
+ *	An \ref in_place_object whose storage is drawn
+ *	from and returned to a per-thread \ref free_list
+ *	rather than the global heap.
+ *
+ *	Since \ref object has a virtual destructor the
+ *	storage is recycled even when a pooled_object
+ *	is destroyed through a std::unique_ptr to
+ *	\ref object.
+ *
+ *	\tparam T
+ *		The type of object.
+ */
+template <typename T>
+class pooled_object : public in_place_object<T> {
+private:
+	using list = free_list<sizeof(in_place_object<T>),alignof(in_place_object<T>)>;
+public:
+	using in_place_object<T>::in_place_object;
+	static void * operator new (std::size_t size) {
+		//	Classes derived from this class are larger
+		//	and can't use the blocks from this list
+		if (size != sizeof(pooled_object)) return ::operator new(size);
+		return list::allocate();
+	}
+	static void operator delete (void * ptr, std::size_t size) noexcept {
+		if (size != sizeof(pooled_object)) ::operator delete(ptr);
+		else list::deallocate(ptr);
+	}
+};
+
+}
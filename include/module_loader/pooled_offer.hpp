@@ -0,0 +1,72 @@
+/**
+ *	\file
+ */
+
+#pragma once
+
+#include "object.hpp"
+#include "pool.hpp"
+#include "pooled_object.hpp"
+#include "variadic_offer.hpp"
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace module_loader {
+
+/**
+ *	An offer which generates \ref pooled_object
+ *	objects when fulfilled.
+ *
+ *	Behaves exactly like \ref in_place_offer except
+ *	that the storage for the resulting objects (and,
+ *	when fulfilled through \ref fulfill_shared, their
+ *	control blocks) is recycled through per-thread
+ *	free lists.  This makes repeatedly fulfilling the
+ *	offer for short lived objects free of heap
+ *	allocations once a steady state is reached.
+ *
+ *	\tparam T
+ *		The type of object to offer.
+ *	\tparam Ts
+ *		The types of objects to request.  Exactly one
+ *		instance of each such type shall be requested
+ *		and shall be passed through to a constructor
+ *		of \em T when the offer is fulfilled.
+ */
+template <typename T, typename... Ts>
+class pooled_offer : public variadic_offer<T,Ts...> {
+private:
+	using base = variadic_offer<T,Ts...>;
+	using object_type = pooled_object<T>;
+public:
+	using fulfill_type = typename base::fulfill_type;
+private:
+	template <std::size_t... Is>
+	std::unique_ptr<object> fulfill (const fulfill_type & objects, std::index_sequence<Is...>) {
+		return std::make_unique<object_type>(
+			*this,
+			*static_cast<Ts *>(*objects[Is].first)...
+		);
+	}
+	template <std::size_t... Is>
+	std::shared_ptr<object> fulfill_shared (const fulfill_type & objects, std::index_sequence<Is...>) {
+		return std::allocate_shared<object_type>(
+			pool_allocator<object_type>{},
+			*this,
+			*static_cast<Ts *>(*objects[Is].first)...
+		);
+	}
+public:
+	using base::base;
+	virtual std::unique_ptr<object> fulfill (const fulfill_type & objects) override {
+		base::check_requests(objects);
+		return fulfill(objects,base::index_sequence);
+	}
+	virtual std::shared_ptr<object> fulfill_shared (const fulfill_type & objects) override {
+		base::check_requests(objects);
+		return fulfill_shared(objects,base::index_sequence);
+	}
+};
+
+}
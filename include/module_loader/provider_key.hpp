@@ -0,0 +1,126 @@
+/**
+ *	\file
+ */
+
+#pragma once
+
+#include "offer.hpp"
+#include "request.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+namespace module_loader {
+
+/**
+ *	Determines the order of the \ref offer objects
+ *	which provide a certain type.
+ *
+ *	The order matters since an \ref offer which both
+ *	provides and requests a type (e.g. a decorator)
+ *	is only fulfilled by the providers which follow
+ *	it.
+ */
+class provider_key {
+private:
+	bool requests_;
+	std::size_t upper_;
+	std::size_t lower_;
+	std::size_t sequence_;
+public:
+	/**
+	 *	Creates a provider_key.
+	 *
+	 *	\param [in] r
+	 *		A pointer to the first request the \ref offer
+	 *		makes for the type-in-question or \em nullptr
+	 *		if it makes no such request.
+	 *	\param [in] sequence
+	 *		The position of the \ref offer in the order
+	 *		in which \ref offer objects were obtained.
+	 */
+	provider_key (const request * r, std::size_t sequence) noexcept
+		:	requests_(r != nullptr),
+			upper_(r ? r->upper_bound() : 0),
+			lower_(r ? r->lower_bound() : 0),
+			sequence_(sequence)
+	{	}
+	/**
+	 *	Determines whether one \ref offer shall be ordered
+	 *	before another.
+	 *
+	 *	\param [in] other
+	 *		The key of the other \ref offer.
+	 *
+	 *	\return
+	 *		\em true if the \ref offer with this key comes
+	 *		first, \em false otherwise.
+	 */
+	bool operator < (const provider_key & other) const noexcept {
+		//	Offers which both provide and request the
+		//	type-in-question go first
+		if (requests_ != other.requests_) return requests_;
+		//	Amongst those whichever has the higher upper
+		//	bound is ordered before so that it has a greater
+		//	chance of being fulfilled, and otherwise whichever
+		//	has the lower lower bound goes last
+		if (upper_ != other.upper_) return upper_ > other.upper_;
+		if (lower_ != other.lower_) return lower_ > other.lower_;
+		//	Otherwise later offers take precedence
+		return sequence_ > other.sequence_;
+	}
+};
+
+/**
+ *	Finds the first request an \ref offer makes for
+ *	a certain type.
+ *
+ *	\param [in] o
+ *		The \ref offer.
+ *	\param [in] ti
+ *		The type.
+ *
+ *	\return
+ *		A pointer to the request or \em nullptr if
+ *		there is no such request.
+ */
+const request * find_request (const offer & o, const std::type_index & ti) noexcept;
+
+/**
+ *	Sorts the \ref offer objects which provide a
+ *	certain type according to their \ref provider_key.
+ *
+ *	Each key is computed once per provider rather
+ *	than once per comparison.
+ *
+ *	\tparam Find
+ *		The type of \em find.
+ *
+ *	\param [in,out] providers
+ *		The positions of the \ref offer objects in the
+ *		order in which they were obtained.
+ *	\param [in] find
+ *		A function object which, given a position,
+ *		returns what \ref find_request would for that
+ *		\ref offer and the type-in-question.
+ *	\param [in] keyed
+ *		Scratch space, passed in so that it may be reused
+ *		across types.
+ */
+template <typename Find>
+void sort_providers (std::vector<std::size_t> & providers, Find find, std::vector<std::pair<provider_key,std::size_t>> & keyed) {
+	if (providers.size() < 2U) return;
+	keyed.clear();
+	keyed.reserve(providers.size());
+	for (auto i : providers) keyed.emplace_back(provider_key(find(i),i),i);
+	std::sort(keyed.begin(),keyed.end(),[] (const auto & a, const auto & b) noexcept {
+		return a.first < b.first;
+	});
+	std::transform(keyed.begin(),keyed.end(),providers.begin(),[] (const auto & pair) noexcept {
+		return pair.second;
+	});
+}
+
+}
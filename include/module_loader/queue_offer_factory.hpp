@@ -6,6 +6,7 @@
 
 #include "offer.hpp"
 #include "offer_factory.hpp"
+#include <cstddef>
 #include <deque>
 #include <memory>
 
@@ -30,6 +31,15 @@ public:
 	void add (std::unique_ptr<offer> req);
 	virtual std::unique_ptr<offer> next () override;
 	virtual std::shared_ptr<offer> next_shared () override;
+	virtual std::size_t next_batch (batch_type & batch, std::size_t max) override;
+	/**
+	 *	Returns the exact number of \ref offer objects
+	 *	which remain.
+	 *
+	 *	\return
+	 *		The number of \ref offer objects.
+	 */
+	virtual std::size_t size_hint () const noexcept override;
 };
 
 }
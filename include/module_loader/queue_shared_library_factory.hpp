@@ -4,8 +4,10 @@
 
 #pragma once
 
+#include "load_policy.hpp"
 #include "shared_library_factory.hpp"
 #include <boost/dll/shared_library.hpp>
+#include <boost/filesystem.hpp>
 #include <deque>
 
 namespace module_loader {
@@ -18,8 +20,18 @@ namespace module_loader {
 class queue_shared_library_factory : public shared_library_factory {
 private:
 	std::deque<boost::dll::shared_library> q_;
+	load_policy policy_;
 public:
 	queue_shared_library_factory () = default;
+	/**
+	 *	Creates a queue_shared_library_factory which
+	 *	opens shared libraries added by path according
+	 *	to a certain \ref load_policy.
+	 *
+	 *	\param [in] policy
+	 *		The \ref load_policy.
+	 */
+	explicit queue_shared_library_factory (load_policy policy) noexcept;
 	/**
 	 *	Adds a boost::dll::shared_library to the queue.
 	 *
@@ -27,6 +39,14 @@ public:
 	 *		A boost::dll::shared_library.
 	 */
 	void add (boost::dll::shared_library so);
+	/**
+	 *	Opens a shared library according to the
+	 *	\ref load_policy and adds it to the queue.
+	 *
+	 *	\param [in] path
+	 *		The path to the shared library.
+	 */
+	void add (const boost::filesystem::path & path);
 	virtual boost::dll::shared_library next () override;
 };
 
@@ -0,0 +1,36 @@
+/**
+ *	\file
+ */
+
+#pragma once
+
+#include <boost/filesystem.hpp>
+
+namespace module_loader {
+
+/**
+ *	Advises the operating system that a file will
+ *	be read in the near future so that its contents
+ *	may be brought into the page cache ahead of time.
+ *
+ *	This is purely advisory: Failures are not reported
+ *	by throwing and on platforms which provide no such
+ *	facility this function does nothing.
+ *
+ *	\param [in] path
+ *		The path to the file.
+ *	\param [in] populate
+ *		If \em false the advice is issued and this
+ *		function returns immediately while the read
+ *		proceeds in the background.  If \em true the
+ *		file is additionally mapped and its pages faulted
+ *		in before this function returns.  Defaults to
+ *		\em false.
+ *
+ *	\return
+ *		\em true if the advice was issued, \em false
+ *		otherwise.
+ */
+bool readahead (const boost::filesystem::path & path, bool populate = false) noexcept;
+
+}
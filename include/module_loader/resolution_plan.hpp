@@ -0,0 +1,97 @@
+/**
+ *	\file
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace module_loader {
+
+class dag_resolver;
+
+/**
+ *	Records how a \ref dag_resolver resolved a
+ *	dependency graph so that a later \ref dag_resolver
+ *	presented with the same \ref offer objects may
+ *	skip resolution and construct objects directly.
+ *
+ *	\ref offer objects are identified by the order in
+ *	which they were obtained together with their name,
+ *	their type, the types they provide, and their
+ *	requests.  A plan
+ *	is only used if all of these match exactly,
+ *	otherwise the dependency graph is resolved as
+ *	usual.
+ *
+ *	Plans may be written to and read from a compact
+ *	binary representation.
+ */
+class resolution_plan {
+private:
+	friend class dag_resolver;
+	class request {
+	public:
+		std::string type;
+		std::size_t lower;
+		std::size_t upper;
+		std::vector<std::size_t> providers;
+	};
+	class entry {
+	public:
+		std::string name;
+		std::string type;
+		//	Sorted
+		std::vector<std::string> provides;
+		std::vector<request> requests;
+	};
+	//	Indexed by the order in which offers were
+	//	obtained
+	std::vector<entry> entries_;
+	//	The order in which objects are created
+	std::vector<std::size_t> order_;
+public:
+	/**
+	 *	Creates an empty resolution_plan.
+	 */
+	resolution_plan () = default;
+	resolution_plan (const resolution_plan &) = default;
+	resolution_plan (resolution_plan &&) = default;
+	resolution_plan & operator = (const resolution_plan &) = default;
+	resolution_plan & operator = (resolution_plan &&) = default;
+	/**
+	 *	Determines the number of \ref offer objects
+	 *	described by this plan.
+	 *
+	 *	\return
+	 *		The number of \ref offer objects.
+	 */
+	std::size_t size () const noexcept;
+	/**
+	 *	Writes the binary representation of this plan.
+	 *
+	 *	\param [in] os
+	 *		The stream to which to write.  Should be
+	 *		opened in binary mode.
+	 */
+	void write (std::ostream & os) const;
+	/**
+	 *	Reads a plan from its binary representation.
+	 *
+	 *	\param [in] is
+	 *		The stream from which to read.  Should be
+	 *		opened in binary mode.
+	 *
+	 *	\return
+	 *		The resolution_plan.  If the stream does not
+	 *		contain a plan written by \ref write throws
+	 *		\ref error.
+	 */
+	static resolution_plan read (std::istream & is);
+};
+
+}
@@ -5,6 +5,8 @@
 #pragma once
 
 #include "error.hpp"
+#include <memory>
+#include <ostream>
 
 namespace module_loader {
 
@@ -12,8 +14,52 @@ namespace module_loader {
  *	A base class for all resolver errors.
  */
 class resolver_error : public error {
+private:
+	class message;
+	std::shared_ptr<message> message_;
+protected:
+	/**
+	 *	A tag type used to select the constructor
+	 *	which defers formatting of the message
+	 *	returned by \ref what.
+	 */
+	class deferred_t {	};
+	/**
+	 *	Creates a resolver_error whose message is
+	 *	not generated until \ref what is first
+	 *	invoked, at which point \ref format is
+	 *	invoked to generate it.
+	 *
+	 *	This allows derived classes which carry
+	 *	structured diagnostics to be thrown (and
+	 *	caught) without paying to render those
+	 *	diagnostics unless they're actually read.
+	 *
+	 *	\param [in] tag
+	 *		A dummy parameter to indicate that this
+	 *		constructor should be chosen by overload
+	 *		resolution.
+	 *	\param [in] summary
+	 *		A brief message which is returned by
+	 *		\ref what if the full message cannot be
+	 *		generated.
+	 */
+	resolver_error (deferred_t tag, const char * summary);
+	/**
+	 *	Writes the full message to a stream.
+	 *
+	 *	Only invoked for objects created by the
+	 *	constructor which accepts \ref deferred_t.
+	 *	The default implementation writes the
+	 *	summary.
+	 *
+	 *	\param [in] os
+	 *		The stream.
+	 */
+	virtual void format (std::ostream & os) const;
 public:
 	using error::error;
+	virtual const char * what () const noexcept override;
 };
 
 }
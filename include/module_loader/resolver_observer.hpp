@@ -94,6 +94,49 @@ public:
 	 *		An event object representing the event.
 	 */
 	virtual void on_resolve (resolve_event event) = 0;
+	/**
+	 *	Encapsulates information about a begin create
+	 *	event.
+	 */
+	class begin_create_event {
+	private:
+		const module_loader::offer * offer_;
+	public:
+		begin_create_event () = delete;
+		begin_create_event (const begin_create_event &) = default;
+		begin_create_event (begin_create_event &&) = default;
+		begin_create_event & operator = (const begin_create_event &) = default;
+		begin_create_event & operator = (begin_create_event &&) = default;
+		/**
+		 *	Creates a begin_create_event.
+		 *
+		 *	\param [in] offer
+		 *		The offer which is about to be fulfilled.
+		 */
+		explicit begin_create_event (const module_loader::offer & offer) noexcept;
+		/**
+		 *	Retrieves the offer which is about to be
+		 *	fulfilled.
+		 *
+		 *	\return
+		 *		A \ref offer.
+		 */
+		const module_loader::offer & offer () const noexcept;
+	};
+	/**
+	 *	Invoked when the begin create event occurs.
+	 *
+	 *	The begin create event occurs immediately before
+	 *	any \ref offer is fulfilled.  If fulfilling the
+	 *	\ref offer succeeds the begin create event is
+	 *	followed by a create event.
+	 *
+	 *	The default implementation does nothing.
+	 *
+	 *	\param [in] event
+	 *		An event object representing the event.
+	 */
+	virtual void on_begin_create (begin_create_event event);
 	/**
 	 *	Encapsulates information about a create event.
 	 */
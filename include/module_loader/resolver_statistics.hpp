@@ -0,0 +1,237 @@
+/**
+ *	\file
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
+namespace module_loader {
+
+class dag_resolver;
+
+/**
+ *	Statistics which a \ref dag_resolver records
+ *	directly as it resolves a dependency graph.
+ *
+ *	All statistics are held in atomic variables and
+ *	may therefore be read (e.g. by a thread which
+ *	exports metrics) while they are being recorded.
+ *	Figures which describe the dependency graph are
+ *	those of the most recent resolution while figures
+ *	which describe phases accumulate across resolutions
+ *	until \ref reset is invoked.
+ */
+class resolver_statistics {
+public:
+	/**
+	 *	The phases of resolution.
+	 */
+	enum class phase : std::size_t {
+		/**
+		 *	Obtaining \ref offer objects.
+		 */
+		get_offers,
+		/**
+		 *	Matching requests with providers (or applying
+		 *	a \ref resolution_plan).
+		 */
+		create_graph,
+		/**
+		 *	Checking that every request is fulfilled.
+		 */
+		check_graph,
+		/**
+		 *	Ordering the graph and detecting cycles.
+		 */
+		topological_sort,
+		/**
+		 *	Creating objects.
+		 */
+		create,
+		/**
+		 *	Destroying objects.
+		 */
+		destroy
+	};
+	/**
+	 *	The number of phases.
+	 */
+	static constexpr std::size_t phases = 6;
+	/**
+	 *	The number of buckets in the histogram of
+	 *	providers per type.
+	 */
+	static constexpr std::size_t buckets = 16;
+	/**
+	 *	Records the time spent in and heap allocated
+	 *	during a phase over the lifetime of the object.
+	 */
+	class timer {
+	private:
+		resolver_statistics * s_;
+		phase p_;
+		std::chrono::steady_clock::time_point begin_;
+		std::size_t heap_;
+	public:
+		timer () = delete;
+		timer (const timer &) = delete;
+		timer (timer &&) = delete;
+		timer & operator = (const timer &) = delete;
+		timer & operator = (timer &&) = delete;
+		/**
+		 *	Creates a timer.
+		 *
+		 *	\param [in] s
+		 *		A pointer to the resolver_statistics to which
+		 *		to record.  If \em nullptr nothing is recorded.
+		 *	\param [in] p
+		 *		The phase.
+		 */
+		timer (resolver_statistics * s, phase p) noexcept;
+		/**
+		 *	Records.
+		 */
+		~timer () noexcept;
+	};
+private:
+	friend class dag_resolver;
+	std::atomic<std::size_t> nodes_;
+	std::atomic<std::size_t> edges_;
+	std::atomic<std::size_t> types_;
+	std::atomic<std::size_t> max_fan_in_;
+	std::atomic<std::size_t> max_fan_out_;
+	std::atomic<std::size_t> depth_;
+	std::atomic<std::chrono::nanoseconds::rep> critical_path_;
+	std::atomic<std::size_t> providers_ [buckets];
+	std::atomic<std::chrono::nanoseconds::rep> durations_ [phases];
+	std::atomic<long long> allocated_ [phases];
+	std::atomic<std::size_t> resolutions_;
+	void clear_graph () noexcept;
+	void add_providers (std::size_t) noexcept;
+public:
+	/**
+	 *	Creates a resolver_statistics with every figure
+	 *	zero.
+	 */
+	resolver_statistics () noexcept;
+	resolver_statistics (const resolver_statistics &) = delete;
+	resolver_statistics (resolver_statistics &&) = delete;
+	resolver_statistics & operator = (const resolver_statistics &) = delete;
+	resolver_statistics & operator = (resolver_statistics &&) = delete;
+	/**
+	 *	Sets every figure to zero.
+	 */
+	void reset () noexcept;
+	/**
+	 *	Determines the number of times a dependency graph
+	 *	has been resolved.
+	 *
+	 *	\return
+	 *		The count.
+	 */
+	std::size_t resolutions () const noexcept;
+	/**
+	 *	Determines the number of nodes (i.e. \ref offer
+	 *	objects) in the dependency graph.
+	 *
+	 *	\return
+	 *		The count.
+	 */
+	std::size_t nodes () const noexcept;
+	/**
+	 *	Determines the number of edges in the dependency
+	 *	graph, i.e. the number of times a request was
+	 *	fulfilled by a provider.
+	 *
+	 *	\return
+	 *		The count.
+	 */
+	std::size_t edges () const noexcept;
+	/**
+	 *	Determines the number of distinct types provided.
+	 *
+	 *	\return
+	 *		The count.
+	 */
+	std::size_t types () const noexcept;
+	/**
+	 *	Determines the greatest number of providers on
+	 *	which any one node depends.
+	 *
+	 *	\return
+	 *		The count.
+	 */
+	std::size_t max_fan_in () const noexcept;
+	/**
+	 *	Determines the greatest number of nodes which
+	 *	depend on any one node.
+	 *
+	 *	\return
+	 *		The count.
+	 */
+	std::size_t max_fan_out () const noexcept;
+	/**
+	 *	Determines the number of nodes in the longest
+	 *	chain of dependencies.
+	 *
+	 *	\return
+	 *		The count.
+	 */
+	std::size_t depth () const noexcept;
+	/**
+	 *	Determines the time spent creating the objects on
+	 *	the chain of dependencies which took the longest
+	 *	to create, i.e. a lower bound on the time to create
+	 *	all objects however many threads are used.
+	 *
+	 *	\return
+	 *		The time.
+	 */
+	std::chrono::nanoseconds critical_path () const noexcept;
+	/**
+	 *	Retrieves a bucket of the histogram of the number
+	 *	of providers per type.
+	 *
+	 *	\param [in] bucket
+	 *		The bucket.  Bucket \em i counts the types with
+	 *		at least 2<sup>i</sup> and fewer than 2<sup>i + 1</sup>
+	 *		providers (the last bucket counts all types with
+	 *		more).  Must be less than \ref buckets.
+	 *
+	 *	\return
+	 *		The count.
+	 */
+	std::size_t providers (std::size_t bucket) const noexcept;
+	/**
+	 *	Determines the time spent in a phase.
+	 *
+	 *	\param [in] p
+	 *		The phase.
+	 *
+	 *	\return
+	 *		The time.
+	 */
+	std::chrono::nanoseconds duration (phase p) const noexcept;
+	/**
+	 *	Determines the net number of bytes of heap
+	 *	allocated during a phase.
+	 *
+	 *	This is measured for the entire process, so
+	 *	allocations made by other threads at the same time
+	 *	are included.  On platforms where heap use cannot
+	 *	be determined this is zero.
+	 *
+	 *	\param [in] p
+	 *		The phase.
+	 *
+	 *	\return
+	 *		The number of bytes, which is negative if more
+	 *		was freed than allocated.
+	 */
+	long long allocated (phase p) const noexcept;
+};
+
+}
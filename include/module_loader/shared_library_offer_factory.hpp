@@ -9,12 +9,14 @@
 #include "shared_library_factory.hpp"
 #include "shared_library_offer_factory_observer.hpp"
 #include <boost/dll/shared_library.hpp>
+#include <cstddef>
 #include <deque>
 #include <exception>
 #include <memory>
 #include <stdexcept>
 #include <string>
 #include <typeinfo>
+#include <vector>
 
 namespace module_loader {
 
@@ -25,21 +27,43 @@ namespace module_loader {
  *	The function in each shared library is expected to
  *	take a reference to an instance of this class as
  *	its first and only parameter.
+ *
+ *	\ref offer objects added by a function are
+ *	attributed to the shared library in which that
+ *	function was found by way of a context associated
+ *	with the thread on which it is invoked.  This allows
+ *	the functions of several shared libraries to be
+ *	invoked concurrently (see \ref concurrency).
  */
 class shared_library_offer_factory : public offer_factory {
 private:
 	shared_library_factory & slf_;
 	shared_library_offer_factory_observer * o_;
 	std::deque<std::unique_ptr<offer>> offers_;
-	boost::dll::shared_library curr_;
 	std::string name_;
-	bool next_active_;
+	std::size_t concurrency_;
+	class load_context {
+	public:
+		shared_library_offer_factory * owner;
+		boost::dll::shared_library so;
+		std::deque<std::unique_ptr<offer>> offers;
+		//	If non-null add events are recorded here
+		//	rather than being dispatched immediately
+		std::vector<const offer *> * added;
+		load_context * prev;
+	};
+	static thread_local load_context * context_;
 	bool get_offers ();
+	bool load_sequentially ();
+	bool load_concurrently ();
+	void invoke (load_context &);
+	void collect (load_context &);
 	std::unique_ptr<offer> next_impl ();
-	void check_add () const;
-	void dispatch_add (const offer &);
-	void dispatch_begin_load ();
-	void dispatch_end_load();
+	std::size_t next_batch_impl (batch_type &, std::size_t);
+	load_context & context () const;
+	void dispatch_add (const boost::dll::shared_library &, const offer &);
+	void dispatch_begin_load (const boost::dll::shared_library &);
+	void dispatch_end_load (const boost::dll::shared_library &);
 public:
 	/**
 	 *	Thrown when an exception is thrown from a function
@@ -91,18 +115,71 @@ public:
 	explicit shared_library_offer_factory (shared_library_factory & slf, shared_library_offer_factory_observer & o);
 	virtual std::unique_ptr<offer> next () override;
 	virtual std::shared_ptr<offer> next_shared () override;
+	virtual std::size_t next_batch (batch_type & batch, std::size_t max) override;
+	/**
+	 *	Returns the number of \ref offer objects from
+	 *	shared libraries which have already been loaded
+	 *	which have not yet been retrieved.  Shared
+	 *	libraries which have yet to be loaded are not
+	 *	counted.
+	 *
+	 *	\return
+	 *		The number of \ref offer objects.
+	 */
+	virtual std::size_t size_hint () const noexcept override;
 	/**
 	 *	Adds an \ref offer to the collection of
 	 *	\ref offer objects generated by the shared
-	 *	library currently being loaded.  If invoked
-	 *	from outside the load handler of a shared
-	 *	library the behavior is undefined.
+	 *	library whose load handler is executing on
+	 *	the calling thread.  If invoked other than from
+	 *	a load handler invoked by this object throws
+	 *	std::logic_error.
 	 *
 	 *	\param [in] o
 	 *		A smart pointer to the \ref offer.
 	 */
 	void add (std::unique_ptr<offer> o);
 	void add (std::shared_ptr<offer> o);
+	/**
+	 *	Sets the number of load handlers which may be
+	 *	invoked concurrently.  Defaults to 1.
+	 *
+	 *	If greater than 1 up to that many shared
+	 *	libraries are obtained at a time and their load
+	 *	handlers are each invoked on a separate thread.
+	 *	\ref offer objects are nonetheless yielded in the
+	 *	order in which the shared libraries were obtained.
+	 *
+	 *	The events for each shared library are dispatched
+	 *	on the calling thread, in that same order, once
+	 *	all the load handlers have returned.  Accordingly
+	 *	observers which measure what happens between the
+	 *	begin load and end load events (e.g.
+	 *	\ref memory_usage_observer) cannot attribute
+	 *	anything to the shared libraries in this mode.
+	 *
+	 *	If a load handler throws the \ref offer objects
+	 *	of every shared library obtained at the same time
+	 *	(including those the throwing load handler added
+	 *	before it threw, as when loading one at a time)
+	 *	are retained and yielded by subsequent calls.  The
+	 *	exception from the first such shared library to
+	 *	throw is thrown once all the load handlers have
+	 *	returned.
+	 *
+	 *	\param [in] n
+	 *		The number of load handlers.  Zero is treated
+	 *		as 1.
+	 */
+	void concurrency (std::size_t n) noexcept;
+	/**
+	 *	Determines the number of load handlers which
+	 *	may be invoked concurrently.
+	 *
+	 *	\return
+	 *		The number of load handlers.
+	 */
+	std::size_t concurrency () const noexcept;
 };
 
 }
@@ -0,0 +1,335 @@
+/**
+ *	\file
+ */
+
+#pragma once
+
+#include "function_offer.hpp"
+#include "in_place_offer.hpp"
+#include "type_traits.hpp"
+#include <cstddef>
+#include <initializer_list>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace module_loader {
+
+/**
+ *	A list of types.
+ *
+ *	\tparam Ts
+ *		The types.
+ */
+template <typename... Ts>
+class type_list {	};
+
+/**
+ *	Describes the object offered by a certain type of
+ *	\ref offer, and how to construct it without invoking
+ *	the \ref offer, at compile time.
+ *
+ *	Specializations shall provide:
+ *
+ *	- \em value_type, the type of object offered
+ *	- \em requests_type, a \ref type_list of the types
+ *	  requested, exactly one of each
+ *	- \em state_type, the type of any state the \ref offer
+ *	  requires to construct the object (e.g. a functor)
+ *	- A static function \em construct which accepts a
+ *	  pointer to suitably aligned storage, a reference to
+ *	  the state, and an lvalue of each requested type and
+ *	  which constructs a \em value_type in that storage
+ *
+ *	Specializations are provided for \ref in_place_offer
+ *	and \ref function_offer.
+ *
+ *	\tparam Offer
+ *		The type of \ref offer.
+ */
+template <typename Offer>
+class static_offer_traits;
+
+template <typename T, typename... Ts>
+class static_offer_traits<in_place_offer<T,Ts...>> {
+public:
+	using value_type = T;
+	using requests_type = type_list<Ts...>;
+	using state_type = std::tuple<>;
+	static void construct (void * where, state_type &, Ts &... args) {
+		::new (where) T(args...);
+	}
+};
+
+template <typename F, typename... Ts>
+class static_offer_traits<function_offer<F,Ts...>> {
+public:
+	using value_type = detail::function_offer_t<F,Ts...>;
+	static_assert(
+		!(detail::is_function_offer_reference_v<F,Ts...> || std::is_same<value_type,void>::value),
+		"Functors in a static dependency graph must return objects by value"
+	);
+	using requests_type = type_list<Ts...>;
+	using state_type = F;
+	static void construct (void * where, state_type & func, Ts &... args) {
+		::new (where) value_type(func(args...));
+	}
+};
+
+namespace detail {
+
+//	Requests are fulfilled by objects of the type
+//	requested or of a type derived therefrom, just as
+//	public_unambiguous_bases makes them at runtime
+template <typename Provided, typename Requested>
+constexpr bool static_fulfills = std::is_same<Provided,Requested>::value || is_public_unambiguous_base_of_v<Requested,Provided>;
+
+template <typename T, typename... Offers>
+class static_provider;
+
+template <typename T>
+class static_provider<T> {
+public:
+	static constexpr std::size_t index = 0;
+	static constexpr std::size_t count = 0;
+};
+
+template <typename T, typename Offer, typename... Offers>
+class static_provider<T,Offer,Offers...> {
+private:
+	using rest = static_provider<T,Offers...>;
+	static constexpr bool provides = static_fulfills<typename static_offer_traits<Offer>::value_type,T>;
+public:
+	//	The index of the first provider or the number of
+	//	offers if there is none
+	static constexpr std::size_t index = provides ? 0 : (rest::index + 1);
+	static constexpr std::size_t count = rest::count + (provides ? 1 : 0);
+};
+
+//	Instantiated for each request so that the compiler
+//	names the offer and the type when diagnosing
+template <typename Offer, typename Requested, std::size_t Count>
+class static_request_check {
+	static_assert(Count != 0,"No offer provides a type requested in a static dependency graph");
+	static_assert(Count < 2,"More than one offer provides a type requested in a static dependency graph");
+public:
+	static constexpr bool value = Count == 1;
+};
+
+template <typename Offer, std::size_t Count>
+class static_offer_check {
+	static_assert(Count < 2,"More than one offer in a static dependency graph provides the same type");
+public:
+	static constexpr bool value = Count == 1;
+};
+
+template <typename Offer, bool Acyclic>
+class static_cycle_check {
+	static_assert(Acyclic,"An offer in a static dependency graph depends on itself (possibly indirectly)");
+public:
+	static constexpr bool value = Acyclic;
+};
+
+constexpr bool static_all (std::initializer_list<bool> list) noexcept {
+	for (auto b : list) if (!b) return false;
+	return true;
+}
+
+constexpr std::size_t static_count (std::initializer_list<bool> list) noexcept {
+	std::size_t retr = 0;
+	for (auto b : list) if (b) ++retr;
+	return retr;
+}
+
+//	void if the index is out of range
+template <std::size_t I, typename... Offers>
+class static_offer_at {
+public:
+	using type = void;
+};
+
+template <typename Offer, typename... Offers>
+class static_offer_at<0,Offer,Offers...> {
+public:
+	using type = Offer;
+};
+
+template <std::size_t I, typename Offer, typename... Offers>
+class static_offer_at<I,Offer,Offers...> : public static_offer_at<I - 1,Offers...> {	};
+
+//	The dependencies of an offer, terminated by the
+//	number of offers
+template <std::size_t N, std::size_t... Is>
+class static_dependencies {
+public:
+	static constexpr std::size_t value [] = {Is...,N};
+};
+
+template <std::size_t N, std::size_t... Is>
+constexpr std::size_t static_dependencies<N,Is...>::value [];
+
+template <typename Offer, typename Requests, typename... Offers>
+class static_requests;
+
+template <typename Offer, typename... Ts, typename... Offers>
+class static_requests<Offer,type_list<Ts...>,Offers...> {
+public:
+	static constexpr bool provided = static_all({static_request_check<Offer,Ts,static_provider<Ts,Offers...>::count>::value...});
+	static constexpr const std::size_t * dependencies = static_dependencies<sizeof...(Offers),static_provider<Ts,Offers...>::index...>::value;
+};
+
+template <std::size_t N>
+class static_order {
+public:
+	std::size_t value [N + 1];
+	//	The index of an offer on a cycle or N if
+	//	there are no cycles
+	std::size_t cycle;
+};
+
+//	Kahn's algorithm, keeping the order in which the
+//	offers were given wherever that is possible
+template <std::size_t N>
+constexpr static_order<N> static_topological_sort (const std::size_t * const * dependencies) {
+	static_order<N> retr{{},N};
+	bool done [N + 1] {};
+	std::size_t count = 0;
+	bool progress = true;
+	while (progress && (count != N)) {
+		progress = false;
+		for (std::size_t i = 0; i < N; ++i) {
+			if (done[i]) continue;
+			bool ready = true;
+			for (auto ptr = dependencies[i]; *ptr != N; ++ptr) if (!done[*ptr]) {
+				ready = false;
+				break;
+			}
+			if (!ready) continue;
+			done[i] = true;
+			retr.value[count++] = i;
+			progress = true;
+			//	Restart so that earlier offers go first
+			break;
+		}
+	}
+	if (count == N) return retr;
+	//	Each offer which remains depends on another which
+	//	remains so following such dependencies N times
+	//	must end on a cycle
+	std::size_t i = 0;
+	while (done[i]) ++i;
+	for (std::size_t n = 0; n < N; ++n) {
+		auto ptr = dependencies[i];
+		while (done[*ptr]) ++ptr;
+		i = *ptr;
+	}
+	retr.cycle = i;
+	return retr;
+}
+
+template <typename Order, typename Indices>
+class static_order_sequence;
+
+template <typename Order, std::size_t... Is>
+class static_order_sequence<Order,std::index_sequence<Is...>> {
+public:
+	using type = std::index_sequence<Order::order.value[Is]...>;
+};
+
+}
+
+/**
+ *	Verifies and orders the dependency graph formed
+ *	by a list of \ref offer types at compile time.
+ *
+ *	A request is fulfilled by the \ref offer whose object
+ *	is of the type requested or of a type of which the
+ *	type requested is a publicly accessible, unambiguous
+ *	base class.  Exactly one \ref offer shall fulfill each
+ *	request, no two \ref offer objects shall offer the same
+ *	type, and the graph shall be acyclic.  Otherwise
+ *	compilation fails with a diagnostic which names the
+ *	\ref offer (and request) at fault.
+ *
+ *	\tparam Offers
+ *		The types of \ref offer, each of which shall have
+ *		a specialization of \ref static_offer_traits.
+ */
+template <typename... Offers>
+class static_dependency_graph {
+private:
+	template <typename Offer>
+	using traits = static_offer_traits<Offer>;
+	template <typename Offer>
+	using requests = detail::static_requests<Offer,typename traits<Offer>::requests_type,Offers...>;
+	template <typename Offer>
+	using unique = detail::static_offer_check<
+		Offer,
+		detail::static_count({std::is_same<typename traits<Offer>::value_type,typename traits<Offers>::value_type>::value...})
+	>;
+	static constexpr const std::size_t * dependencies_ [sizeof...(Offers) + 1] = {requests<Offers>::dependencies...,nullptr};
+public:
+	/**
+	 *	The number of \ref offer types.
+	 */
+	static constexpr std::size_t size = sizeof...(Offers);
+	/**
+	 *	The result of sorting the graph.
+	 */
+	static constexpr detail::static_order<size> order = detail::static_topological_sort<size>(dependencies_);
+	/**
+	 *	Obtains the type of the \ref offer at a certain
+	 *	index.
+	 *
+	 *	\tparam I
+	 *		The index.
+	 */
+	template <std::size_t I>
+	using offer_type = std::tuple_element_t<I,std::tuple<Offers...>>;
+	/**
+	 *	Obtains the index of the \ref offer which
+	 *	provides a certain type.
+	 *
+	 *	\tparam T
+	 *		The type.  Exactly one \ref offer shall provide
+	 *		this type.
+	 */
+	template <typename T>
+	class provider {
+	private:
+		using impl = detail::static_provider<T,Offers...>;
+		static_assert(impl::count != 0,"No offer in the static dependency graph provides the type");
+		static_assert(impl::count < 2,"More than one offer in the static dependency graph provides the type");
+	public:
+		static constexpr std::size_t index = impl::index;
+	};
+	/**
+	 *	A std::index_sequence of the indices of the
+	 *	\ref offer types in an order in which their
+	 *	objects may be constructed.
+	 */
+	using order_type = typename detail::static_order_sequence<
+		static_dependency_graph,
+		std::make_index_sequence<size>
+	>::type;
+	/**
+	 *	\em true.  Evaluating this verifies the graph.
+	 */
+	static constexpr bool value =
+		detail::static_all({requests<Offers>::provided...}) &&
+		detail::static_all({unique<Offers>::value...}) &&
+		detail::static_cycle_check<
+			typename detail::static_offer_at<order.cycle,Offers...>::type,
+			order.cycle == size
+		>::value;
+};
+
+template <typename... Offers>
+constexpr const std::size_t * static_dependency_graph<Offers...>::dependencies_ [];
+template <typename... Offers>
+constexpr detail::static_order<static_dependency_graph<Offers...>::size> static_dependency_graph<Offers...>::order;
+template <typename... Offers>
+constexpr bool static_dependency_graph<Offers...>::value;
+
+}
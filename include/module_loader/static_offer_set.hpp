@@ -0,0 +1,181 @@
+/**
+ *	\file
+ */
+
+#pragma once
+
+#include "static_dependency_graph.hpp"
+#include <cassert>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace module_loader {
+
+/**
+ *	Constructs a fixed set of objects whose \ref offer
+ *	types are known at compile time.
+ *
+ *	Providers are matched with requests, and the order in
+ *	which the objects must be constructed is determined,
+ *	at compile time.  Objects are stored inline and
+ *	constructed by direct constructor calls.  No \ref offer
+ *	or \ref object is created and nothing is invoked
+ *	virtually.
+ *
+ *	The requirements on the \ref offer types are those of
+ *	\ref static_dependency_graph, which diagnoses any
+ *	violation thereof at compile time.
+ *
+ *	\tparam Offers
+ *		The types of \ref offer, each of which shall have
+ *		a specialization of \ref static_offer_traits.
+ */
+template <typename... Offers>
+class static_offer_set {
+public:
+	/**
+	 *	The number of objects.
+	 */
+	static constexpr std::size_t size = sizeof...(Offers);
+private:
+	template <typename Offer>
+	using traits = static_offer_traits<Offer>;
+	template <std::size_t I>
+	using offer_t = std::tuple_element_t<I,std::tuple<Offers...>>;
+	template <std::size_t I>
+	using value_t = typename traits<offer_t<I>>::value_type;
+	using graph = static_dependency_graph<Offers...>;
+	static_assert(graph::value,"The offers in a static_offer_set must form a valid dependency graph");
+	std::tuple<typename traits<Offers>::state_type...> states_;
+	std::tuple<std::aligned_storage_t<sizeof(typename traits<Offers>::value_type),alignof(typename traits<Offers>::value_type)>...> storage_;
+	std::size_t constructed_;
+	template <typename T>
+	T & object () noexcept {
+		constexpr auto i = graph::template provider<T>::index;
+		return *reinterpret_cast<value_t<i> *>(&std::get<i>(storage_));
+	}
+	template <std::size_t I, typename... Ts>
+	void construct (type_list<Ts...>) {
+		traits<offer_t<I>>::construct(&std::get<I>(storage_),std::get<I>(states_),object<Ts>()...);
+	}
+	template <std::size_t I>
+	void construct () {
+		construct<I>(typename traits<offer_t<I>>::requests_type{});
+		++constructed_;
+	}
+	template <std::size_t I>
+	static void destroy (static_offer_set & self) noexcept {
+		using type = value_t<I>;
+		reinterpret_cast<type *>(&std::get<I>(self.storage_))->~type();
+	}
+	template <std::size_t... Is>
+	void create (std::index_sequence<Is...>) {
+		using expand = int [];
+		(void)expand{0,(construct<Is>(),0)...};
+	}
+	template <std::size_t... Is>
+	void destroy (std::index_sequence<Is...>) noexcept {
+		using destroy_type = void (*) (static_offer_set &);
+		static constexpr destroy_type destroyers [] = {&destroy<Is>...,nullptr};
+		while (constructed_ != 0) destroyers[--constructed_](*this);
+	}
+public:
+	/**
+	 *	Creates a static_offer_set whose objects have
+	 *	not been constructed.
+	 *
+	 *	Available only if each \em state_type is default
+	 *	constructible.
+	 */
+	static_offer_set () : constructed_(0) {	}
+	/**
+	 *	Creates a static_offer_set whose objects have
+	 *	not been constructed.
+	 *
+	 *	\param [in] states
+	 *		The state for each \ref offer (e.g. the functor
+	 *		for a \ref function_offer) in the order in which
+	 *		the offers are given.  \em {} suffices for an
+	 *		\ref in_place_offer.
+	 */
+	explicit static_offer_set (typename traits<Offers>::state_type... states)
+		:	states_(std::move(states)...),
+			constructed_(0)
+	{	}
+	static_offer_set (const static_offer_set &) = delete;
+	static_offer_set (static_offer_set &&) = delete;
+	static_offer_set & operator = (const static_offer_set &) = delete;
+	static_offer_set & operator = (static_offer_set &&) = delete;
+	/**
+	 *	Destroys the objects, if they have been
+	 *	constructed, in the reverse order of their
+	 *	construction.
+	 */
+	~static_offer_set () noexcept {
+		clear();
+	}
+	/**
+	 *	Constructs each object after the objects it
+	 *	requests.
+	 *
+	 *	If a constructor throws the objects already
+	 *	constructed are destroyed and the exception is
+	 *	propagated.  If the objects have already been
+	 *	constructed does nothing.
+	 */
+	void create () {
+		if (constructed_ == size) return;
+		try {
+			create(typename graph::order_type{});
+		} catch (...) {
+			clear();
+			throw;
+		}
+	}
+	/**
+	 *	Destroys the objects in the reverse order of
+	 *	their construction.
+	 */
+	void clear () noexcept {
+		destroy(typename graph::order_type{});
+	}
+	/**
+	 *	Determines whether the objects have been
+	 *	constructed.
+	 *
+	 *	\return
+	 *		\em true if \ref create has been invoked and
+	 *		\ref clear has not since been invoked, \em false
+	 *		otherwise.
+	 */
+	bool created () const noexcept {
+		return constructed_ == size;
+	}
+	/**
+	 *	Retrieves an object.  If the objects have not been
+	 *	constructed the behavior is undefined.
+	 *
+	 *	\tparam T
+	 *		The type of object.  Exactly one \ref offer shall
+	 *		offer this type or a type derived therefrom.
+	 *
+	 *	\return
+	 *		A reference to the object.
+	 */
+	template <typename T>
+	T & get () noexcept {
+		assert(created());
+		return object<T>();
+	}
+	template <typename T>
+	const T & get () const noexcept {
+		return const_cast<static_offer_set &>(*this).template get<T>();
+	}
+};
+
+template <typename... Offers>
+constexpr std::size_t static_offer_set<Offers...>::size;
+
+}
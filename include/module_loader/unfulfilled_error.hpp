@@ -19,6 +19,9 @@ namespace module_loader {
  *	Thrown when one or more \ref request objects
  *	associated with one or more \ref offer objects
  *	cannot be fulfilled.
+ *
+ *	The message returned by \ref what is only
+ *	generated when first requested.
  */
 class unfulfilled_error : public resolver_error {
 public:
@@ -140,6 +143,8 @@ public:
 	using entries_type = std::vector<entry>;
 private:
 	entries_type entries_;
+protected:
+	virtual void format (std::ostream &) const override;
 public:
 	unfulfilled_error () = delete;
 	unfulfilled_error (const unfulfilled_error &) = default;
@@ -0,0 +1,121 @@
+#include <module_loader/asynchronous_offer_factory.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace module_loader {
+
+void asynchronous_offer_factory::run () noexcept {
+	for (;;) {
+		std::unique_ptr<offer> ptr;
+		std::exception_ptr ex;
+		try {
+			ptr = inner_.next();
+		} catch (...) {
+			ex = std::current_exception();
+		}
+		auto hint = inner_.size_hint();
+		std::unique_lock<std::mutex> l(m_);
+		if (stop_) return;
+		inner_hint_ = hint;
+		if (ex) ex_ = std::move(ex);
+		bool done = !ptr;
+		if (ptr) {
+			try {
+				q_.push_back(std::move(ptr));
+			} catch (...) {
+				ex_ = std::current_exception();
+				done = true;
+			}
+		}
+		if (ex_) done = true;
+		done_ = done;
+		l.unlock();
+		cv_.notify_one();
+		if (done) return;
+	}
+}
+
+void asynchronous_offer_factory::start () {
+	if (started_) return;
+	inner_hint_ = inner_.size_hint();
+	t_ = std::thread([this] () noexcept {	run();	});
+	started_ = true;
+}
+
+asynchronous_offer_factory::asynchronous_offer_factory (offer_factory & inner)
+	:	inner_(inner),
+		inner_hint_(0),
+		started_(false),
+		done_(false),
+		stop_(false)
+{	}
+
+asynchronous_offer_factory::~asynchronous_offer_factory () noexcept {
+	{
+		std::lock_guard<std::mutex> l(m_);
+		stop_ = true;
+	}
+	if (t_.joinable()) t_.join();
+}
+
+bool asynchronous_offer_factory::wait (std::unique_lock<std::mutex> & l) {
+	start();
+	cv_.wait(l,[&] () noexcept {	return done_ || !q_.empty();	});
+	if (!q_.empty()) return true;
+	if (!ex_) return false;
+	//	Only report the error once, subsequent
+	//	calls simply indicate exhaustion
+	auto ex = std::move(ex_);
+	ex_ = nullptr;
+	std::rethrow_exception(std::move(ex));
+}
+
+std::unique_ptr<offer> asynchronous_offer_factory::next () {
+	std::unique_lock<std::mutex> l(m_);
+	if (!wait(l)) return std::unique_ptr<offer>{};
+	auto retr = std::move(q_.front());
+	q_.pop_front();
+	return retr;
+}
+
+std::shared_ptr<offer> asynchronous_offer_factory::next_shared () {
+	auto ptr = next();
+	if (!ptr) return std::shared_ptr<offer>{};
+	return std::shared_ptr<offer>(ptr.release());
+}
+
+std::size_t asynchronous_offer_factory::next_batch (batch_type & batch, std::size_t max) {
+	std::size_t retr(0);
+	std::unique_lock<std::mutex> l(m_);
+	//	Take everything which is buffered each time
+	//	the lock is acquired rather than one at a time
+	while (retr != max) {
+		//	A short batch signals exhaustion so a pending
+		//	exception must be thrown rather than returning
+		//	early, the offers already appended remain in
+		//	the batch
+		if (!wait(l)) break;
+		auto n = std::min(max - retr,q_.size());
+		auto begin = q_.begin();
+		auto end = begin + n;
+		for (auto iter = begin; iter != end; ++iter) batch.emplace_back(std::move(*iter));
+		q_.erase(begin,end);
+		retr += n;
+	}
+	return retr;
+}
+
+std::size_t asynchronous_offer_factory::size_hint () const noexcept {
+	std::lock_guard<std::mutex> l(m_);
+	//	Until the background thread is started the
+	//	wrapped offer_factory is only used from this
+	//	thread
+	return q_.size() + (started_ ? inner_hint_ : inner_.size_hint());
+}
+
+}
@@ -0,0 +1,82 @@
+#include "binary_io.hpp"
+#include <module_loader/error.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <string>
+
+namespace module_loader {
+namespace detail {
+
+binary_writer::binary_writer (std::ostream & os) noexcept : os_(os) {	}
+
+void binary_writer::magic (const char (& m) [8]) {
+	os_.write(m,sizeof(m));
+}
+
+void binary_writer::integer (std::uint64_t u) {
+	char buffer [8];
+	for (auto && c : buffer) {
+		c = static_cast<char>(u & 0xFFU);
+		u >>= 8U;
+	}
+	os_.write(buffer,sizeof(buffer));
+}
+
+void binary_writer::string (const std::string & str) {
+	integer(str.size());
+	os_.write(str.data(),str.size());
+}
+
+binary_reader::binary_reader (std::istream & is, const char * what) noexcept : is_(is), what_(what) {	}
+
+void binary_reader::malformed () const {
+	throw error(what_);
+}
+
+void binary_reader::magic (const char (& m) [8]) {
+	char buffer [sizeof(m)];
+	if (!is_.read(buffer,sizeof(buffer)) || !std::equal(buffer,buffer + sizeof(buffer),m)) malformed();
+}
+
+std::uint64_t binary_reader::integer () {
+	char buffer [8];
+	if (!is_.read(buffer,sizeof(buffer))) malformed();
+	std::uint64_t u(0);
+	for (std::size_t i = sizeof(buffer); i != 0; --i) {
+		u <<= 8U;
+		u |= static_cast<unsigned char>(buffer[i - 1U]);
+	}
+	return u;
+}
+
+std::size_t binary_reader::size () {
+	auto u = integer();
+	if (u > std::numeric_limits<std::size_t>::max()) malformed();
+	return static_cast<std::size_t>(u);
+}
+
+std::string binary_reader::string () {
+	auto remaining = size();
+	//	Read in chunks so that a corrupt size results
+	//	in an exception rather than an enormous allocation
+	std::string retr;
+	char buffer [4096];
+	while (remaining != 0) {
+		auto n = std::min(remaining,sizeof(buffer));
+		if (!is_.read(buffer,n)) malformed();
+		retr.append(buffer,n);
+		remaining -= n;
+	}
+	return retr;
+}
+
+std::size_t binary_reader::reserve (std::size_t size) noexcept {
+	return std::min<std::size_t>(size,1024);
+}
+
+}
+}
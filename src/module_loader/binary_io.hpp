@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+
+namespace module_loader {
+namespace detail {
+
+//	Helpers shared by the binary representations of
+//	module_loader::resolution_plan and
+//	module_loader::construction_profile:  Integers are
+//	little endian and eight bytes wide regardless of
+//	platform and strings are prefixed by their length
+
+class binary_writer {
+private:
+	std::ostream & os_;
+public:
+	explicit binary_writer (std::ostream & os) noexcept;
+	void magic (const char (& m) [8]);
+	void integer (std::uint64_t u);
+	void string (const std::string & str);
+};
+
+//	Throws module_loader::error with the given message
+//	on malformed input.  Nothing is ever allocated based
+//	on a size read from the stream without first reading
+//	that much so that a corrupt size cannot result in an
+//	enormous allocation
+class binary_reader {
+private:
+	std::istream & is_;
+	const char * what_;
+public:
+	binary_reader (std::istream & is, const char * what) noexcept;
+	[[noreturn]]
+	void malformed () const;
+	void magic (const char (& m) [8]);
+	std::uint64_t integer ();
+	std::size_t size ();
+	std::string string ();
+	//	How many elements to reserve when reading a
+	//	sequence of a certain size
+	static std::size_t reserve (std::size_t size) noexcept;
+};
+
+}
+}
@@ -0,0 +1,330 @@
+#include <boost/filesystem.hpp>
+#include <boost/system/error_code.hpp>
+#include <module_loader/concurrent_directory_scanning_shared_library_factory.hpp>
+#include <module_loader/directory_entry_filter.hpp>
+#include <module_loader/readahead.hpp>
+#include <module_loader/shared_library_directory_entry_filter.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+#ifndef _WIN32
+#include <cerrno>
+#include <cstring>
+#include <dirent.h>
+#endif
+
+namespace module_loader {
+
+namespace {
+
+using entries_type = std::vector<boost::filesystem::directory_entry>;
+
+#ifdef _WIN32
+template <typename Iterator>
+void scan (const boost::filesystem::path & dir, entries_type & entries) {
+	for (auto && entry : Iterator(dir)) {
+		if (!boost::filesystem::is_directory(entry.symlink_status())) entries.push_back(entry);
+	}
+}
+
+void scan (const boost::filesystem::path & dir, bool recursive, entries_type & entries) {
+	if (recursive) scan<boost::filesystem::recursive_directory_iterator>(dir,entries);
+	else for (auto && entry : boost::filesystem::directory_iterator(dir)) entries.push_back(entry);
+}
+#else
+[[noreturn]]
+void raise (const char * what, const boost::filesystem::path & path) {
+	throw boost::filesystem::filesystem_error(
+		what,
+		path,
+		boost::system::error_code(errno,boost::system::system_category())
+	);
+}
+
+boost::filesystem::file_type get_type (unsigned char type) noexcept {
+	switch (type) {
+	case DT_REG:
+		return boost::filesystem::regular_file;
+	case DT_DIR:
+		return boost::filesystem::directory_file;
+	case DT_LNK:
+		return boost::filesystem::symlink_file;
+	case DT_BLK:
+		return boost::filesystem::block_file;
+	case DT_CHR:
+		return boost::filesystem::character_file;
+	case DT_FIFO:
+		return boost::filesystem::fifo_file;
+	case DT_SOCK:
+		return boost::filesystem::socket_file;
+	default:
+		break;
+	}
+	//	The file system did not report the type (i.e.
+	//	DT_UNKNOWN) so we'll have to stat
+	return boost::filesystem::status_error;
+}
+
+void scan (const boost::filesystem::path & dir, bool recursive, entries_type & entries) {
+	std::vector<boost::filesystem::path> pending;
+	pending.push_back(dir);
+	while (!pending.empty()) {
+		auto curr = std::move(pending.back());
+		pending.pop_back();
+		std::unique_ptr<DIR,int (*) (DIR *)> d(::opendir(curr.c_str()),&::closedir);
+		if (!d) raise("opendir",curr);
+		for (;;) {
+			errno = 0;
+			auto ent = ::readdir(d.get());
+			if (!ent) {
+				if (errno != 0) raise("readdir",curr);
+				break;
+			}
+			auto name = ent->d_name;
+			if ((std::strcmp(name,".") == 0) || (std::strcmp(name,"..") == 0)) continue;
+			auto path = curr / name;
+			auto type = get_type(ent->d_type);
+			boost::filesystem::file_status symlink_status(type);
+			if (type == boost::filesystem::status_error) {
+				boost::system::error_code ec;
+				symlink_status = boost::filesystem::symlink_status(path,ec);
+				//	The entry may have been removed since the
+				//	directory was read
+				if (symlink_status.type() == boost::filesystem::file_not_found) continue;
+				if (ec) throw boost::filesystem::filesystem_error("symlink_status",path,ec);
+			}
+			type = symlink_status.type();
+			if (recursive && (type == boost::filesystem::directory_file)) {
+				pending.push_back(std::move(path));
+				continue;
+			}
+			//	The status of the target of a symbolic link
+			//	is left unknown so that it's only retrieved
+			//	if someone asks for it
+			boost::filesystem::file_status status;
+			if (type != boost::filesystem::symlink_file) status = symlink_status;
+			entries.emplace_back(std::move(path),status,symlink_status);
+		}
+	}
+}
+#endif
+
+entries_type scan (boost::filesystem::path dir, bool recursive) {
+	entries_type retr;
+	scan(dir,recursive,retr);
+	std::sort(retr.begin(),retr.end(),[] (const auto & a, const auto & b) noexcept {
+		return a.path() < b.path();
+	});
+	return retr;
+}
+
+//	Shared by the threads which scan so that each
+//	takes the next directory in order as soon as it
+//	finishes with the last
+class scan_queue {
+private:
+	std::vector<boost::filesystem::path> paths_;
+	std::vector<std::promise<entries_type>> promises_;
+	std::atomic<std::size_t> next_;
+	bool recursive_;
+public:
+	scan_queue (std::vector<boost::filesystem::path> paths, bool recursive)
+		:	paths_(std::move(paths)),
+			promises_(paths_.size()),
+			next_(0),
+			recursive_(recursive)
+	{	}
+	std::future<entries_type> get_future (std::size_t i) {
+		return promises_[i].get_future();
+	}
+	void run () noexcept {
+		for (;;) {
+			auto i = next_.fetch_add(1,std::memory_order_relaxed);
+			if (i >= paths_.size()) return;
+			try {
+				promises_[i].set_value(scan(paths_[i],recursive_));
+			} catch (...) {
+				promises_[i].set_exception(std::current_exception());
+			}
+		}
+	}
+};
+
+std::size_t default_concurrency () noexcept {
+	auto retr = std::thread::hardware_concurrency();
+	return (retr == 0) ? 1U : retr;
+}
+
+}
+
+void concurrent_directory_scanning_shared_library_factory::start () {
+	auto queue = std::make_shared<scan_queue>(std::vector<boost::filesystem::path>(paths_.begin(),paths_.end()),recursive_);
+	for (std::size_t i = 0; i < paths_.size(); ++i) scans_.push_back(queue->get_future(i));
+	auto n = std::min(concurrency_,paths_.size());
+	for (std::size_t i = 0; i < n; ++i) workers_.push_back(std::async(std::launch::async,[queue] () noexcept {	queue->run();	}));
+}
+
+bool concurrent_directory_scanning_shared_library_factory::next_path () {
+	auto end = paths_.cend();
+	if (path_) {
+		if (*path_ == end) return false;
+		dispatch_end_directory();
+		++*path_;
+	} else {
+		start();
+		path_ = paths_.cbegin();
+	}
+	if (*path_ == end) return false;
+	auto scan = std::move(scans_.front());
+	scans_.pop_front();
+	entries_ = scan.get();
+	entry_ = 0;
+	prefetched_ = 0;
+	dispatch_begin_directory();
+	shared_library_directory_entry_filter fallback;
+	directory_entry_filter & filter = filter_ ? *filter_ : fallback;
+	entries_.erase(
+		std::remove_if(entries_.begin(),entries_.end(),[&] (const auto & entry) {
+			return !filter.check(entry);
+		}),
+		entries_.end()
+	);
+	return true;
+}
+
+const boost::filesystem::directory_entry * concurrent_directory_scanning_shared_library_factory::next_library () {
+	while (entry_ == entries_.size()) {
+		if (!next_path()) return nullptr;
+	}
+	return &entries_[entry_++];
+}
+
+void concurrent_directory_scanning_shared_library_factory::prefetch () {
+	if (readahead_ == 0) return;
+	auto end = std::min(entries_.size(),entry_ + readahead_);
+	//	Reap background population which has finished
+	//	so this doesn't grow without bound
+	while (!populating_.empty() && (populating_.front().wait_for(std::chrono::seconds(0)) == std::future_status::ready)) {
+		populating_.pop_front();
+	}
+	for (auto i = std::max(prefetched_,entry_); i < end; ++i) {
+		auto && path = entries_[i].path();
+		//	Once enough threads are busy faulting in pages
+		//	the remaining files are merely read ahead
+		if (populate_ && (populating_.size() < concurrency_)) {
+			populating_.push_back(std::async(std::launch::async,[path] () noexcept {
+				module_loader::readahead(path,true);
+			}));
+		} else {
+			module_loader::readahead(path);
+		}
+	}
+	prefetched_ = std::max(prefetched_,end);
+}
+
+void concurrent_directory_scanning_shared_library_factory::dispatch_begin_directory () const {
+	if (!o_) return;
+	directory_scanning_shared_library_factory_observer::begin_directory_event e(**path_);
+	o_->on_begin_directory(std::move(e));
+}
+
+void concurrent_directory_scanning_shared_library_factory::dispatch_end_directory () const {
+	if (!o_) return;
+	directory_scanning_shared_library_factory_observer::end_directory_event e(**path_);
+	o_->on_end_directory(std::move(e));
+}
+
+void concurrent_directory_scanning_shared_library_factory::dispatch_load (const boost::dll::shared_library & so, std::chrono::steady_clock::duration duration) const {
+	if (!o_) return;
+	directory_scanning_shared_library_factory_observer::load_event e(so,duration);
+	o_->on_load(std::move(e));
+}
+
+concurrent_directory_scanning_shared_library_factory::concurrent_directory_scanning_shared_library_factory ()
+	:	recursive_(false),
+		concurrency_(default_concurrency()),
+		entry_(0),
+		prefetched_(0),
+		readahead_(0),
+		populate_(false),
+		filter_(nullptr),
+		o_(nullptr)
+{	}
+
+concurrent_directory_scanning_shared_library_factory::concurrent_directory_scanning_shared_library_factory (directory_entry_filter & filter)
+	:	concurrent_directory_scanning_shared_library_factory()
+{
+	filter_ = &filter;
+}
+
+concurrent_directory_scanning_shared_library_factory::concurrent_directory_scanning_shared_library_factory (directory_scanning_shared_library_factory_observer & o)
+	:	concurrent_directory_scanning_shared_library_factory()
+{
+	o_ = &o;
+}
+
+concurrent_directory_scanning_shared_library_factory::concurrent_directory_scanning_shared_library_factory (directory_entry_filter & filter, directory_scanning_shared_library_factory_observer & o)
+	:	concurrent_directory_scanning_shared_library_factory(filter)
+{
+	o_ = &o;
+}
+
+boost::dll::shared_library concurrent_directory_scanning_shared_library_factory::next () {
+	auto entry = next_library();
+	if (!entry) return boost::dll::shared_library{};
+	prefetch();
+	auto begin = std::chrono::steady_clock::now();
+	auto retr = policy_.load(entry->path());
+	dispatch_load(retr,std::chrono::steady_clock::now() - begin);
+	return retr;
+}
+
+[[noreturn]]
+static void started () {
+	throw std::logic_error("Do not configure a module_loader::concurrent_directory_scanning_shared_library_factory after scanning has begun");
+}
+
+bool concurrent_directory_scanning_shared_library_factory::add (boost::filesystem::path path) {
+	if (path_) started();
+	path = boost::filesystem::canonical(path);
+	auto pair = paths_.insert(std::move(path));
+	return pair.second;
+}
+
+void concurrent_directory_scanning_shared_library_factory::recursive (bool recursive) {
+	if (path_) started();
+	recursive_ = recursive;
+}
+
+void concurrent_directory_scanning_shared_library_factory::concurrency (std::size_t n) {
+	if (path_) started();
+	concurrency_ = (n == 0U) ? 1U : n;
+}
+
+std::size_t concurrent_directory_scanning_shared_library_factory::concurrency () const noexcept {
+	return concurrency_;
+}
+
+void concurrent_directory_scanning_shared_library_factory::readahead (std::size_t count, bool populate) {
+	if (path_) started();
+	readahead_ = count;
+	populate_ = populate;
+}
+
+void concurrent_directory_scanning_shared_library_factory::policy (load_policy policy) noexcept {
+	policy_ = policy;
+}
+
+const load_policy & concurrent_directory_scanning_shared_library_factory::policy () const noexcept {
+	return policy_;
+}
+
+}
@@ -0,0 +1,123 @@
+#include <module_loader/concurrent_queue_offer_factory.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace module_loader {
+
+void concurrent_queue_offer_factory::destroy (node * ptr) noexcept {
+	while (ptr) {
+		auto next = ptr->next;
+		delete ptr;
+		ptr = next;
+	}
+}
+
+bool concurrent_queue_offer_factory::before (const node & a, const node & b) noexcept {
+	if (a.producer != b.producer) return a.producer < b.producer;
+	return a.sequence < b.sequence;
+}
+
+concurrent_queue_offer_factory::node * concurrent_queue_offer_factory::merge (node * a, node * b) noexcept {
+	node * retr = nullptr;
+	auto tail = &retr;
+	while (a && b) {
+		//	Refers to whichever of a and b is taken from
+		//	so that it may be advanced
+		auto && first = before(*b,*a) ? b : a;
+		*tail = first;
+		tail = &first->next;
+		first = first->next;
+	}
+	*tail = a ? a : b;
+	return retr;
+}
+
+concurrent_queue_offer_factory::node * concurrent_queue_offer_factory::sort (node * list) noexcept {
+	//	Merge sort so that nothing need be allocated
+	if (!list || !list->next) return list;
+	auto slow = list;
+	auto fast = list->next;
+	while (fast && fast->next) {
+		slow = slow->next;
+		fast = fast->next->next;
+	}
+	auto second = slow->next;
+	slow->next = nullptr;
+	return merge(sort(list),sort(second));
+}
+
+bool concurrent_queue_offer_factory::drain () noexcept {
+	auto head = head_.exchange(nullptr,std::memory_order_acquire);
+	if (!head) return front_ != nullptr;
+	front_ = merge(front_,sort(head));
+	back_ = back_ ? back_ : front_;
+	while (back_->next) back_ = back_->next;
+	return true;
+}
+
+std::unique_ptr<offer> concurrent_queue_offer_factory::pop () noexcept {
+	auto ptr = front_;
+	front_ = ptr->next;
+	if (!front_) back_ = nullptr;
+	auto retr = std::move(ptr->value);
+	delete ptr;
+	size_.fetch_sub(1,std::memory_order_relaxed);
+	return retr;
+}
+
+concurrent_queue_offer_factory::concurrent_queue_offer_factory () noexcept
+	:	head_(nullptr),
+		sequence_(0),
+		size_(0),
+		front_(nullptr),
+		back_(nullptr)
+{	}
+
+concurrent_queue_offer_factory::~concurrent_queue_offer_factory () noexcept {
+	destroy(front_);
+	destroy(head_.load(std::memory_order_acquire));
+}
+
+void concurrent_queue_offer_factory::add (std::size_t producer, std::unique_ptr<offer> req) {
+	auto sequence = sequence_.fetch_add(1,std::memory_order_relaxed);
+	auto ptr = new node{std::move(req),producer,sequence,head_.load(std::memory_order_relaxed)};
+	//	Counted before it is visible so that the count
+	//	cannot be decremented below zero
+	size_.fetch_add(1,std::memory_order_relaxed);
+	while (!head_.compare_exchange_weak(ptr->next,ptr,std::memory_order_release,std::memory_order_relaxed));
+}
+
+void concurrent_queue_offer_factory::add (std::unique_ptr<offer> req) {
+	add(0,std::move(req));
+}
+
+std::unique_ptr<offer> concurrent_queue_offer_factory::next () {
+	if (!front_ && !drain()) return std::unique_ptr<offer>{};
+	return pop();
+}
+
+std::shared_ptr<offer> concurrent_queue_offer_factory::next_shared () {
+	auto ptr = next();
+	if (!ptr) return std::shared_ptr<offer>{};
+	return std::shared_ptr<offer>(ptr.release());
+}
+
+std::size_t concurrent_queue_offer_factory::next_batch (batch_type & batch, std::size_t max) {
+	drain();
+	std::size_t n(0);
+	for (; front_ && (n != max); ++n) {
+		//	Only unlinked once ownership has been
+		//	transferred so that nothing is lost if
+		//	this throws
+		batch.emplace_back(std::move(front_->value));
+		pop();
+	}
+	return n;
+}
+
+std::size_t concurrent_queue_offer_factory::size_hint () const noexcept {
+	return size_.load(std::memory_order_relaxed);
+}
+
+}
@@ -0,0 +1,66 @@
+#include "binary_io.hpp"
+#include <module_loader/construction_profile.hpp>
+#include <module_loader/offer.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <utility>
+
+namespace module_loader {
+
+namespace {
+
+constexpr char magic [] = {'M','L','P','R','O','F','0','1'};
+constexpr const char * malformed = "Malformed construction profile";
+
+}
+
+std::string construction_profile::key (const offer & o) {
+	std::string retr(o.name());
+	retr.push_back('\0');
+	retr += o.type().name();
+	return retr;
+}
+
+std::size_t construction_profile::size () const noexcept {
+	return durations_.size();
+}
+
+void construction_profile::record (const offer & o, duration d) {
+	durations_[key(o)] = d.count();
+}
+
+optional<construction_profile::duration> construction_profile::find (const offer & o) const {
+	auto iter = durations_.find(key(o));
+	if (iter == durations_.end()) return nullopt;
+	return duration(iter->second);
+}
+
+void construction_profile::write (std::ostream & os) const {
+	detail::binary_writer w(os);
+	w.magic(magic);
+	w.integer(durations_.size());
+	for (auto && pair : durations_) {
+		w.string(pair.first);
+		w.integer(static_cast<std::uint64_t>(std::max<duration::rep>(pair.second,0)));
+	}
+}
+
+construction_profile construction_profile::read (std::istream & is) {
+	detail::binary_reader r(is,malformed);
+	r.magic(magic);
+	construction_profile retr;
+	auto n = r.integer();
+	for (std::uint64_t i = 0; i < n; ++i) {
+		auto k = r.string();
+		auto d = r.integer();
+		if (d > static_cast<std::uint64_t>(std::numeric_limits<duration::rep>::max())) r.malformed();
+		retr.durations_[std::move(k)] = static_cast<duration::rep>(d);
+	}
+	return retr;
+}
+
+}
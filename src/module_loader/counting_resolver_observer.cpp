@@ -2,12 +2,16 @@
 
 namespace module_loader {
 
-counting_resolver_observer::counting_resolver_observer () : resolve_(0), create_(0), destroy_(0) {	}
+counting_resolver_observer::counting_resolver_observer () : resolve_(0), begin_create_(0), create_(0), destroy_(0) {	}
 
 void counting_resolver_observer::on_resolve (resolve_event) {
 	++resolve_;
 }
 
+void counting_resolver_observer::on_begin_create (begin_create_event) {
+	++begin_create_;
+}
+
 void counting_resolver_observer::on_create (create_event) {
 	++create_;
 }
@@ -20,6 +24,10 @@ std::size_t counting_resolver_observer::resolve () const noexcept {
 	return resolve_;
 }
 
+std::size_t counting_resolver_observer::begin_create () const noexcept {
+	return begin_create_;
+}
+
 std::size_t counting_resolver_observer::create () const noexcept {
 	return create_;
 }
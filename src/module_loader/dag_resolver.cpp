@@ -1,79 +1,112 @@
-#include <boost/function_output_iterator.hpp>
-#include <boost/iterator/counting_iterator.hpp>
-#include <boost/iterator/zip_iterator.hpp>
-#include <boost/tuple/tuple.hpp>
-#include <module_loader/algorithm.hpp>
+#include <module_loader/construction_profile.hpp>
 #include <module_loader/dag_resolver.hpp>
 #include <module_loader/not_a_dag_error.hpp>
 #include <module_loader/offer.hpp>
+#include <module_loader/provider_key.hpp>
 #include <module_loader/resolver_observer.hpp>
 #include <module_loader/type_name.hpp>
 #include <module_loader/unfulfilled_error.hpp>
 #include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
 #include <cstddef>
+#include <deque>
+#include <exception>
 #include <iterator>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <typeindex>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace module_loader {
 
 namespace {
 
-enum class provides_category {
-	both,
-	requests,
-	provides
-};
+constexpr auto npos = std::numeric_limits<std::size_t>::max();
 
-provides_category get_provides_category (const offer & o, const std::type_index & ti) noexcept {
-	bool provides = o.provides().count(ti) != 0;
-	if (!provides) return provides_category::requests;
-	auto && rs = o.requests();
-	auto end = rs.end();
-	bool requests = std::find_if(rs.begin(),end,[&] (const auto & request) noexcept {
-		return std::type_index(request.type()) == ti;
-	}) != end;
-	if (!requests) return provides_category::provides;
-	return provides_category::both;
-}
-
-}
-
-dag_resolver::node::node (std::shared_ptr<module_loader::offer> offer)
-	:	offer_(std::move(offer)),
-		object_(nullptr)
-{
-	depends_on_.resize(offer_->requests().size());
-}
-
-bool dag_resolver::node::ordered_before (const node & other, const std::type_index & ti) const noexcept {
-	auto cat_a = get_provides_category(*offer_,ti);
-	if (cat_a == provides_category::provides) return false;
-	auto cat_b = get_provides_category(*other.offer_,ti);
-	if (cat_b == provides_category::provides) return false;
-	if (cat_a == provides_category::requests) return cat_b != provides_category::requests;
-	//	Both provide and request the type-in-question,
-	//	we decide that whichever has the higher upper
-	//	bound is ordered before so that it has a greater
-	//	chance of being fulfilled
-	auto && a_reqs = offer_->requests();
-	auto && b_reqs = other.offer_->requests();
-	auto func = [&] (const auto & offer) noexcept {
-		return std::type_index(offer.type()) == ti;
-	};
-	//	We assume these are found otherwise we'd have
-	//	returned above
-	auto && req_a = *std::find_if(a_reqs.begin(),a_reqs.end(),func);
-	auto && req_b = *std::find_if(b_reqs.begin(),b_reqs.end(),func);
-	if (req_a.upper_bound() != req_b.upper_bound()) return req_a.upper_bound() > req_b.upper_bound();
-	//	Otherwise whichever has the lower lower bound
-	//	goes last
-	return req_a.lower_bound() > req_b.lower_bound();
+std::vector<std::string> provided_names (const offer & o) {
+	std::vector<std::string> retr;
+	retr.reserve(o.provides().size());
+	for (auto && t : o.provides()) retr.emplace_back(t.name());
+	std::sort(retr.begin(),retr.end());
+	return retr;
+}
+
+//	Events are serialized only when objects are
+//	being constructed concurrently
+std::unique_lock<std::mutex> lock_if (std::mutex * m) {
+	if (!m) return std::unique_lock<std::mutex>();
+	return std::unique_lock<std::mutex>(*m);
+}
+
+}
+
+dag_resolver::result::result (unfulfilled_error::entries_type unfulfilled, not_a_dag_error::cycles_type cycles) noexcept
+	:	unfulfilled_(std::move(unfulfilled)),
+		cycles_(std::move(cycles))
+{	}
+
+const unfulfilled_error::entries_type & dag_resolver::result::unfulfilled () const noexcept {
+	return unfulfilled_;
+}
+
+const not_a_dag_error::cycles_type & dag_resolver::result::cycles () const noexcept {
+	return cycles_;
+}
+
+dag_resolver::result::operator bool () const noexcept {
+	return unfulfilled_.empty() && cycles_.empty();
+}
+
+dag_resolver::node::node (std::shared_ptr<module_loader::offer> offer) : offer_(std::move(offer)) {
+	auto && rs = offer_->requests();
+	requests_.reserve(rs.size());
+	for (std::size_t i = 0; i < rs.size(); ++i) requests_.emplace_back(rs[i].type(),i);
+	//	Stable so that where a type is requested more
+	//	than once the first such request is found
+	std::stable_sort(requests_.begin(),requests_.end(),[] (const auto & a, const auto & b) noexcept {
+		return a.first < b.first;
+	});
+	auto && ps = offer_->provides();
+	positions_.reserve(ps.size());
+	for (auto && t : ps) positions_.emplace_back(t,npos);
+	std::sort(positions_.begin(),positions_.end());
+}
+
+dag_resolver::node::index_type::const_iterator dag_resolver::node::find (const index_type & index, const std::type_index & ti) noexcept {
+	auto end = index.end();
+	auto iter = std::lower_bound(index.begin(),end,ti,[] (const auto & pair, const std::type_index & ti) noexcept {
+		return pair.first < ti;
+	});
+	if ((iter == end) || (iter->first != ti)) return end;
+	return iter;
+}
+
+const request * dag_resolver::node::find_request (const std::type_index & ti) const noexcept {
+	auto iter = find(requests_,ti);
+	if (iter == requests_.end()) return nullptr;
+	return &offer_->requests()[iter->second];
+}
+
+optional<std::size_t> dag_resolver::node::position (const std::type_index & ti) const noexcept {
+	auto iter = find(positions_,ti);
+	if (iter == positions_.end()) return nullopt;
+	return iter->second;
+}
+
+void dag_resolver::node::position (const std::type_index & ti, std::size_t pos) noexcept {
+	auto iter = find(positions_,ti);
+	assert(iter != positions_.end());
+	positions_[iter - positions_.begin()].second = pos;
 }
 
 offer & dag_resolver::node::offer () noexcept {
@@ -88,280 +121,598 @@ std::shared_ptr<offer> dag_resolver::node::offer_shared () const noexcept {
 	return offer_;
 }
 
-optional<unfulfilled_error::entry> dag_resolver::node::check_fulfilled () const {
-	using entry = unfulfilled_error::entry;
-	entry::requests_type requests;
-	auto && rs = offer_->requests();
-	std::for_each(
-		boost::make_zip_iterator(
-			boost::make_tuple(
-				rs.begin(),
-				depends_on_.begin(),
-				boost::counting_iterator<std::size_t>(0)
-			)
-		),
-		boost::make_zip_iterator(
-			boost::make_tuple(
-				rs.end(),
-				depends_on_.end(),
-				boost::make_counting_iterator(rs.size())
-			)
-		),
-		[&] (const auto & tuple) {
-			auto && r = boost::get<0>(tuple);
-			auto && nodes = boost::get<1>(tuple);
-			auto && i = boost::get<2>(tuple);
-			auto n = nodes.size();
-			if ((n >= r.lower_bound()) && (n <= r.upper_bound())) return;
-			entry::request_details::fulfilled_by_type fulfilled_by;
-			fulfilled_by.reserve(nodes.size());
-			std::transform(nodes.begin(),nodes.end(),std::back_inserter(fulfilled_by),[] (const auto & ptr) noexcept {
-				return ptr->offer_;
-			});
-			requests.emplace_back(i,r,std::move(fulfilled_by));
-		}
-	);
-	if (requests.empty()) return nullopt;
-	return entry(offer_,std::move(requests));
-}
-
 [[noreturn]]
 static void out_of_range () {
 	throw std::out_of_range("Index out of bounds");
 }
 
-void dag_resolver::node::resolve (std::size_t i, node & depends_on) {
-	if (i >= depends_on_.size()) out_of_range();
-	depends_on.depended_on_by_.push_back(this);
-	depends_on_[i].push_back(&depends_on);
+dag_resolver::range_type dag_resolver::depends_on (std::size_t i, std::size_t j) const noexcept {
+	auto r = request_offsets_[i] + j;
+	auto begin = edges_.data();
+	return range_type(begin + edge_offsets_[r],begin + edge_offsets_[r + 1]);
 }
 
-const dag_resolver::node::children_type & dag_resolver::node::children () const noexcept {
-	return depended_on_by_;
+dag_resolver::range_type dag_resolver::children (std::size_t i) const noexcept {
+	auto begin = children_.data();
+	return range_type(begin + child_offsets_[i],begin + child_offsets_[i + 1]);
 }
 
-std::unique_ptr<object> dag_resolver::node::create () {
-	std::vector<std::vector<void *>> objs;
-	objs.reserve(depends_on_.size());
-	std::transform(depends_on_.begin(),depends_on_.end(),std::back_inserter(objs),[] (const auto & nodes) {
-		std::vector<void *> retr;
-		retr.reserve(nodes.size());
-		std::transform(nodes.begin(),nodes.end(),std::back_inserter(retr),[] (auto ptr) {
-			auto obj = ptr->object_;
-			if (obj) return obj->get();
-			throw std::logic_error("Incorrect construction order");
-		});
-		return retr;
-	});
-	offer::fulfill_type fulfill;
-	fulfill.reserve(depends_on_.size());
-	std::transform(objs.begin(),objs.end(),std::back_inserter(fulfill),[] (auto & vec) noexcept {
-		return std::make_pair(vec.data(),vec.size());
-	});
-	auto retr = offer_->fulfill(fulfill);
-	if (!retr) throw std::logic_error("module_loader::offer::fulfill returned std::unique_ptr which does not manage a pointee");
-	object_ = retr.get();
-	return retr;
+void dag_resolver::begin_request (std::size_t i, std::size_t j) noexcept {
+	edge_offsets_[request_offsets_[i] + j] = edges_.size();
 }
 
-bool dag_resolver::node::leaf () const noexcept {
-	return std::all_of(depends_on_.begin(),depends_on_.end(),[] (const auto & vec) noexcept {
-		return vec.empty();
-	});
-}
-
-template <typename Set>
-bool dag_resolver::node::next (const Set & set) const noexcept {
-	return std::all_of(depends_on_.begin(),depends_on_.end(),[&] (const auto & vec) noexcept {
-		return std::all_of(vec.begin(),vec.end(),[&] (auto ptr) noexcept {
-			return set.count(ptr) != 0;
-		});
-	});
-}
-
-void dag_resolver::do_resolve (node & depends, std::size_t i, node & depends_on) {
-	depends.resolve(i,depends_on);
-	if (!ro_) return;
-	auto && o = depends.offer();
+void dag_resolver::do_resolve (std::size_t depends, std::size_t i, std::size_t depends_on) {
+	auto && o = nodes_[depends].offer();
 	auto && rs = o.requests();
 	if (i >= rs.size()) out_of_range();
-	resolver_observer::resolve_event e(o,depends_on.offer(),rs[i]);
+	edges_.push_back(depends_on);
+	if (!ro_) return;
+	resolver_observer::resolve_event e(o,nodes_[depends_on].offer(),rs[i]);
 	ro_->on_resolve(std::move(e));
 }
 
-std::unique_ptr<object> dag_resolver::do_create (node & n) {
-	auto retr = n.create();
+bool dag_resolver::timed () const noexcept {
+	return stats_ || profile_;
+}
+
+std::unique_ptr<object> dag_resolver::do_create (std::size_t i, std::mutex * m) {
+	auto && n = nodes_[i];
+	if (ro_) {
+		auto l = lock_if(m);
+		resolver_observer::begin_create_event e(n.offer());
+		ro_->on_begin_create(std::move(e));
+	}
+	//	The providers for all requests of a node are
+	//	contiguous so the objects may be gathered into
+	//	a single buffer
+	auto first = request_offsets_[i];
+	auto last = request_offsets_[i + 1];
+	auto begin = edge_offsets_[first];
+	std::vector<void *> objs;
+	objs.reserve(edge_offsets_[last] - begin);
+	for (auto e = begin; e != edge_offsets_[last]; ++e) {
+		auto obj = node_objects_[edges_[e]];
+		if (!obj) throw std::logic_error("Incorrect construction order");
+		objs.push_back(obj->get());
+	}
+	offer::fulfill_type fulfill;
+	fulfill.reserve(last - first);
+	for (auto r = first; r != last; ++r) fulfill.emplace_back(objs.data() + (edge_offsets_[r] - begin),edge_offsets_[r + 1] - edge_offsets_[r]);
+	auto t = timed();
+	auto begin_time = t ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+	auto retr = n.offer().fulfill(fulfill);
+	if (t) node_durations_[i] = std::chrono::steady_clock::now() - begin_time;
+	if (!retr) throw std::logic_error("module_loader::offer::fulfill returned std::unique_ptr which does not manage a pointee");
+	node_objects_[i] = retr.get();
 	if (!ro_) return retr;
+	auto l = lock_if(m);
 	resolver_observer::create_event e(n.offer(),*retr);
 	ro_->on_create(std::move(e));
 	return retr;
 }
 
 void dag_resolver::get_offers () {
+	if (catalog_) {
+		//	The catalog never changes so there is
+		//	nothing more to get after the first time
+		if (nodes_.empty()) add_catalog();
+		return;
+	}
+	//	Reserve once up front rather than growing (and
+	//	rehashing) an offer at a time
+	auto hint = of_->size_hint();
+	if (hint != 0U) {
+		nodes_.reserve(nodes_.size() + hint);
+		provides_map_.reserve(provides_map_.size() + hint);
+	}
+	offer_factory::batch_type batch;
+	batch.reserve(batch_size);
 	for (;;) {
-		auto ptr = of_.next_shared();
-		if (!ptr) break;
-		auto node_ptr = std::make_unique<node>(std::move(ptr));
-		auto && node = *node_ptr;
-		nodes_.push_back(std::move(node_ptr));
-		for (auto && t : node.offer().provides()) {
-			//	This will default construct if it does not
-			//	already exist, which is exactly what we
-			//	want
-			auto && v = provides_map_[t];
-			//	Simplest case: This is the only offer
-			//	(so far) which provides the type
-			if (v.empty()) {
-				v.push_back(&node);
-				continue;
-			}
-			//	This is the complex case: Other offers
-			//	provide the type.  We attempt to reconcile
-			//	this
-			v.insert(
-				std::lower_bound(v.begin(),v.end(),&node,[&] (const auto & a, const auto & b) noexcept {
-					return a->ordered_before(*b,t);
-				}),
-				&node
-			);
+		batch.clear();
+		auto n = of_->next_batch(batch,batch_size);
+		for (auto && ptr : batch) add_offer(std::move(ptr));
+		if (n != batch_size) break;
+	}
+	sort_providers();
+}
+
+void dag_resolver::add_offer (std::shared_ptr<module_loader::offer> ptr) {
+	auto i = nodes_.size();
+	nodes_.emplace_back(std::move(ptr));
+	//	Ordering is deferred until all offers have
+	//	been retrieved (see sort_providers)
+	for (auto && t : nodes_.back().offer().provides()) provides_map_[t].push_back(i);
+}
+
+void dag_resolver::sort_providers () {
+	std::vector<std::pair<provider_key,std::size_t>> keyed;
+	for (auto && pair : provides_map_) {
+		auto && t = pair.first;
+		auto && v = pair.second;
+		//	Each node indexes its requests so there is no
+		//	need to search them as module_loader::find_request
+		//	would
+		module_loader::sort_providers(v,[&] (std::size_t i) noexcept {	return nodes_[i].find_request(t);	},keyed);
+		for (std::size_t i = 0; i < v.size(); ++i) nodes_[v[i]].position(t,i);
+	}
+}
+
+void dag_resolver::add_catalog () {
+	auto && offers = catalog_->offers();
+	nodes_.reserve(offers.size());
+	for (auto && ptr : offers) nodes_.emplace_back(ptr);
+	for (auto && pair : catalog_->providers()) {
+		auto && t = pair.first;
+		auto && indices = pair.second;
+		auto && v = provides_map_[t];
+		v.reserve(indices.size());
+		for (auto i : indices) {
+			nodes_[i].position(t,v.size());
+			v.push_back(i);
 		}
 	}
 }
 
+void dag_resolver::begin_graph () {
+	//	Discard edges from any previous attempt
+	auto n = nodes_.size();
+	request_offsets_.resize(n + 1U);
+	request_offsets_[0] = 0;
+	for (std::size_t i = 0; i < n; ++i) request_offsets_[i + 1] = request_offsets_[i] + nodes_[i].offer().requests().size();
+	edge_offsets_.assign(request_offsets_.back() + 1U,0);
+	edges_.clear();
+	//	Most requests are fulfilled by exactly one provider
+	edges_.reserve(request_offsets_.back());
+	order_.clear();
+	order_.reserve(n);
+}
+
+void dag_resolver::end_graph () {
+	edge_offsets_.back() = edges_.size();
+	//	Invert the edges by counting sort
+	auto n = nodes_.size();
+	child_offsets_.assign(n + 1U,0);
+	for (auto j : edges_) ++child_offsets_[j + 1];
+	for (std::size_t i = 0; i < n; ++i) child_offsets_[i + 1] += child_offsets_[i];
+	children_.resize(edges_.size());
+	std::vector<std::size_t> next(child_offsets_.begin(),child_offsets_.end() - 1);
+	for (std::size_t i = 0; i < n; ++i) {
+		auto begin = edges_.data() + edge_offsets_[request_offsets_[i]];
+		auto end = edges_.data() + edge_offsets_[request_offsets_[i + 1]];
+		for (; begin != end; ++begin) children_[next[*begin]++] = i;
+	}
+	status_.assign(n,0);
+	node_objects_.assign(n,nullptr);
+	if (timed()) node_durations_.assign(n,std::chrono::steady_clock::duration::zero());
+}
+
 void dag_resolver::create_graph () {
-	for (auto && ptr : nodes_) {
-		auto && offer = ptr->offer();
-		auto && rs = offer.requests();
-		std::for_each(
-			boost::make_zip_iterator(
-				boost::make_tuple(
-					rs.begin(),
-					boost::counting_iterator<std::size_t>(0)
-				)
-			),
-			boost::make_zip_iterator(
-				boost::make_tuple(
-					rs.end(),
-					boost::make_counting_iterator(rs.size())
-				)
-			),
-			[&] (auto && tuple) {
-				auto && r = boost::get<0>(tuple);
-				auto && i = boost::get<1>(tuple);
-				auto && t = r.type();
-				auto iter = provides_map_.find(t);
-				if (iter == provides_map_.end()) return;
-				auto end = iter->second.end();
-				auto begin = iter->second.begin();
-				if (offer.provides().count(t) != 0) begin = std::find(begin,end,ptr.get()) + 1;
-				auto upper = r.upper_bound();
-				std::size_t dist(end - begin);
-				dist = std::min(upper, dist);
-				end = begin + dist;
-				std::for_each(begin,end,[&] (auto node) {	this->do_resolve(*ptr,i,*node);	});
-			}
-		);
+	begin_graph();
+	for (std::size_t i = 0; i < nodes_.size(); ++i) {
+		auto && n = nodes_[i];
+		auto && rs = n.offer().requests();
+		for (std::size_t j = 0; j < rs.size(); ++j) {
+			begin_request(i,j);
+			auto && r = rs[j];
+			auto && t = r.type();
+			auto iter = provides_map_.find(t);
+			if (iter == provides_map_.end()) continue;
+			auto end = iter->second.end();
+			auto begin = iter->second.begin();
+			//	An offer which provides the type it requests
+			//	may only be fulfilled by those after it
+			auto pos = n.position(t);
+			if (pos) begin += *pos + 1;
+			auto upper = r.upper_bound();
+			std::size_t dist(end - begin);
+			dist = std::min(upper, dist);
+			end = begin + dist;
+			std::for_each(begin,end,[&] (auto p) {	this->do_resolve(i,j,p);	});
+		}
 	}
+	end_graph();
 }
 
-void dag_resolver::check_graph () {
-	unfulfilled_error::entries_type entries;
-	for (auto && ptr : nodes_) {
-		auto entry = ptr->check_fulfilled();
-		if (entry) entries.push_back(std::move(*entry));
+optional<unfulfilled_error::entry> dag_resolver::check_fulfilled (std::size_t i) const {
+	using entry = unfulfilled_error::entry;
+	entry::requests_type requests;
+	auto && n = nodes_[i];
+	auto && rs = n.offer().requests();
+	for (std::size_t j = 0; j < rs.size(); ++j) {
+		auto && r = rs[j];
+		auto range = depends_on(i,j);
+		std::size_t count(range.second - range.first);
+		if ((count >= r.lower_bound()) && (count <= r.upper_bound())) continue;
+		entry::request_details::fulfilled_by_type fulfilled_by;
+		fulfilled_by.reserve(count);
+		std::transform(range.first,range.second,std::back_inserter(fulfilled_by),[&] (auto p) noexcept {
+			return nodes_[p].offer_shared();
+		});
+		requests.emplace_back(j,r,std::move(fulfilled_by));
 	}
-	if (!entries.empty()) throw unfulfilled_error(std::move(entries));
+	if (requests.empty()) return nullopt;
+	return entry(n.offer_shared(),std::move(requests));
 }
 
-void dag_resolver::topological_sort () {
-	//	Initialize the stack with leaf nodes
-	std::vector<node *> stack;
-	for (auto && ptr : nodes_) {
-		if (ptr->leaf()) stack.push_back(ptr.get());
+void dag_resolver::check_graph (unfulfilled_error::entries_type & entries) {
+	for (std::size_t i = 0; i < nodes_.size(); ++i) {
+		auto entry = check_fulfilled(i);
+		if (entry) entries.push_back(std::move(*entry));
 	}
-	std::unordered_map<node *,std::size_t> order;
-	not_a_dag_error::cycles_type cycles;
-	std::size_t i(0);
-	while (order.size() != nodes_.size()) {
-		//	Here we handle the case where there were
-		//	no leaf nodes: We just pick a node that
-		//	doesn't have an order yet arbitrarily and
-		//	pretend it's a leaf.  The fact that it isn't
-		//	a leaf is irrelevant because we'll pick up
-		//	cycles and that will prevent this algorithm
-		//	from exiting successfully but will allow us
-		//	to report all cycles
-		if (stack.empty()) {
-			auto iter = std::find_if(nodes_.begin(),nodes_.end(),[&] (const auto & ptr) noexcept {
-				return order.count(ptr.get()) == 0;
-			});
-			stack.push_back(iter->get());
+}
+
+namespace {
+
+enum : unsigned char {
+	on_stack = 1,
+	in_component = 2
+};
+
+}
+
+not_a_dag_error::cycle_type dag_resolver::get_cycle (const std::vector<std::size_t> & component, std::vector<std::size_t> & parents) {
+	//	Find the shortest cycle through the first node
+	//	of the component by searching breadth first
+	//	along edges which stay within the component
+	for (auto i : component) status_[i] |= in_component;
+	auto root = component.front();
+	auto last = npos;
+	std::deque<std::size_t> queue;
+	queue.push_back(root);
+	while (last == npos) {
+		auto i = queue.front();
+		queue.pop_front();
+		auto range = children(i);
+		for (auto iter = range.first; iter != range.second; ++iter) {
+			auto child = *iter;
+			if (!(status_[child] & in_component)) continue;
+			if (child == root) {
+				last = i;
+				break;
+			}
+			if (parents[child] != npos) continue;
+			parents[child] = i;
+			queue.push_back(child);
 		}
-		do {
-			//	We don't pop immediately because we
-			//	need to preserve a trace in case we
-			//	encounter a cycle and need to output
-			//	it to the list of cycles, so we attempt
-			//	to add to the order map.  If this
-			//	succeeds (i.e. the node was not already
-			//	in the collection) then it remains in
-			//	the stack as part of the trace, otherwise
-			//	we're backtracking looking for nodes and
-			//	we can actually pop
-			auto & node = *stack.back();
-			auto pair = order.emplace(&node,i);
-			if (!pair.second) {
-				stack.pop_back();
+	}
+	//	Children depend on their parents, so walking back
+	//	from the last node yields the cycle in the order
+	//	in which each offer depends on the next
+	not_a_dag_error::cycle_type retr;
+	retr.push_back(nodes_[root].offer_shared());
+	for (auto i = last; i != root; i = parents[i]) retr.push_back(nodes_[i].offer_shared());
+	for (auto i : component) {
+		parents[i] = npos;
+		status_[i] &= ~in_component;
+	}
+	return retr;
+}
+
+void dag_resolver::topological_sort (not_a_dag_error::cycles_type & cycles) {
+	//	Tarjan's strongly connected components algorithm:
+	//	Every strongly connected component with more than
+	//	one node is a cycle and is reported exactly once,
+	//	otherwise components are emitted in an order such
+	//	that every node comes after all nodes which depend
+	//	on it
+	auto n = nodes_.size();
+	std::vector<std::size_t> index(n,npos);
+	std::vector<std::size_t> low(n);
+	std::vector<std::size_t> stack;
+	//	Each frame is a node and the position of the next
+	//	child of that node to visit
+	std::vector<std::pair<std::size_t,std::size_t>> frames;
+	std::vector<std::size_t> order;
+	order.reserve(n);
+	std::vector<std::size_t> component;
+	std::vector<std::size_t> parents;
+	std::size_t counter(0);
+	auto visit = [&] (std::size_t i) {
+		index[i] = counter;
+		low[i] = counter;
+		++counter;
+		stack.push_back(i);
+		status_[i] |= on_stack;
+		frames.emplace_back(i,child_offsets_[i]);
+	};
+	for (std::size_t root = 0; root < n; ++root) {
+		if (index[root] != npos) continue;
+		visit(root);
+		while (!frames.empty()) {
+			auto i = frames.back().first;
+			auto & next = frames.back().second;
+			if (next != child_offsets_[i + 1]) {
+				auto child = children_[next++];
+				if (index[child] == npos) visit(child);
+				else if (status_[child] & on_stack) low[i] = std::min(low[i],index[child]);
 				continue;
 			}
-			++i;
-			for (auto && ptr : node.children()) {
-				//	Detect cycles
-				if (order.count(ptr) != 0) {
-					not_a_dag_error::cycle_type cycle;
-					copy_until_inclusive(
-						stack.rbegin(),
-						stack.rend(),
-						boost::make_function_output_iterator([&] (auto ptr) mutable {
-							cycle.push_back(ptr->offer_shared());
-						}),
-						[&] (auto p) noexcept {	return p == ptr;	}
-					);
-					cycles.push_back(std::move(cycle));
-					continue;
-				}
-				//	Skip nodes until we're ready
-				//	to visit them
-				if (!ptr->next(order)) continue;
-				//	Enqueue to be visited
-				stack.push_back(ptr);
+			frames.pop_back();
+			if (!frames.empty()) {
+				auto parent = frames.back().first;
+				low[parent] = std::min(low[parent],low[i]);
 			}
-		} while (!stack.empty());
+			if (low[i] != index[i]) continue;
+			//	i is the root of a strongly connected
+			//	component which consists of it and
+			//	everything above it on the stack
+			//	Search from the top since components are
+			//	usually small and the stack may be deep
+			auto begin = std::find(stack.rbegin(),stack.rend(),i).base() - 1;
+			component.assign(begin,stack.end());
+			stack.erase(begin,stack.end());
+			for (auto j : component) status_[j] &= ~on_stack;
+			if (component.size() == 1U) {
+				order.push_back(i);
+				continue;
+			}
+			if (parents.empty()) parents.resize(n,npos);
+			cycles.push_back(get_cycle(component,parents));
+		}
 	}
-	if (!cycles.empty()) throw not_a_dag_error(std::move(cycles));
-	//	Sort the nodes into the correct order
-	//	for object construction
-	std::sort(nodes_.begin(),nodes_.end(),[&] (const auto & a, const auto & b) noexcept {
-		return order[a.get()] < order[b.get()];
-	});
+	if (!cycles.empty()) return;
+	//	The order in which objects are constructed is
+	//	the reverse of that in which they were emitted
+	order_.assign(order.rbegin(),order.rend());
+}
+
+void dag_resolver::record_graph () {
+	if (!stats_) return;
+	auto && s = *stats_;
+	s.clear_graph();
+	s.resolutions_.fetch_add(1,std::memory_order_relaxed);
+	auto n = nodes_.size();
+	s.nodes_.store(n,std::memory_order_relaxed);
+	s.edges_.store(edges_.size(),std::memory_order_relaxed);
+	for (auto && pair : provides_map_) if (!pair.second.empty()) s.add_providers(pair.second.size());
+	std::size_t fan_in(0);
+	std::size_t fan_out(0);
+	for (std::size_t i = 0; i < n; ++i) {
+		fan_in = std::max(fan_in,edge_offsets_[request_offsets_[i + 1]] - edge_offsets_[request_offsets_[i]]);
+		fan_out = std::max(fan_out,child_offsets_[i + 1] - child_offsets_[i]);
+	}
+	s.max_fan_in_.store(fan_in,std::memory_order_relaxed);
+	s.max_fan_out_.store(fan_out,std::memory_order_relaxed);
+	//	Every node is ordered after the nodes on which
+	//	it depends so the longest chain ending at each
+	//	node may be found in a single pass
+	std::vector<std::size_t> depths(n,0);
+	std::size_t depth(0);
+	for (auto i : order_) {
+		std::size_t d(0);
+		auto begin = edges_.data() + edge_offsets_[request_offsets_[i]];
+		auto end = edges_.data() + edge_offsets_[request_offsets_[i + 1]];
+		for (; begin != end; ++begin) d = std::max(d,depths[*begin]);
+		depths[i] = d + 1U;
+		depth = std::max(depth,depths[i]);
+	}
+	s.depth_.store(depth,std::memory_order_relaxed);
+}
+
+void dag_resolver::record_critical_path () {
+	if (!stats_) return;
+	using duration = std::chrono::steady_clock::duration;
+	std::vector<duration> paths(nodes_.size(),duration::zero());
+	auto critical = duration::zero();
+	for (auto i : order_) {
+		auto d = duration::zero();
+		auto begin = edges_.data() + edge_offsets_[request_offsets_[i]];
+		auto end = edges_.data() + edge_offsets_[request_offsets_[i + 1]];
+		for (; begin != end; ++begin) d = std::max(d,paths[*begin]);
+		paths[i] = d + node_durations_[i];
+		critical = std::max(critical,paths[i]);
+	}
+	stats_->critical_path_.store(std::chrono::duration_cast<std::chrono::nanoseconds>(critical).count(),std::memory_order_relaxed);
+}
+
+void dag_resolver::record_profile () {
+	if (!profile_) return;
+	for (std::size_t i = 0; i < nodes_.size(); ++i) profile_->record(
+		nodes_[i].offer(),
+		std::chrono::duration_cast<construction_profile::duration>(node_durations_[i])
+	);
+}
+
+bool dag_resolver::verify_plan () const {
+	auto && entries = plan_->entries_;
+	auto n = nodes_.size();
+	if (entries.size() != n) return false;
+	for (std::size_t i = 0; i < n; ++i) {
+		auto && e = entries[i];
+		auto && o = nodes_[i].offer();
+		if ((e.name != o.name()) || (e.type != o.type().name())) return false;
+		//	Otherwise a provider which has gained a base
+		//	would go unnoticed
+		if (provided_names(o) != e.provides) return false;
+		auto && rs = o.requests();
+		if (e.requests.size() != rs.size()) return false;
+		for (std::size_t j = 0; j < rs.size(); ++j) {
+			auto && pr = e.requests[j];
+			auto && r = rs[j];
+			if ((pr.type != r.type().name()) || (pr.lower != r.lower_bound()) || (pr.upper != r.upper_bound())) return false;
+			auto count = pr.providers.size();
+			if ((count < r.lower_bound()) || (count > r.upper_bound())) return false;
+			for (auto p : pr.providers) {
+				if (p >= n) return false;
+				if (!nodes_[p].position(r.type())) return false;
+			}
+		}
+	}
+	//	The order must be a permutation in which each
+	//	object is created after all those it depends on
+	auto && order = plan_->order_;
+	if (order.size() != n) return false;
+	std::vector<std::size_t> created(n,npos);
+	for (std::size_t i = 0; i < n; ++i) {
+		auto j = order[i];
+		if ((j >= n) || (created[j] != npos)) return false;
+		created[j] = i;
+	}
+	for (std::size_t i = 0; i < n; ++i) {
+		for (auto && r : entries[i].requests) for (auto p : r.providers) {
+			if (created[p] >= created[i]) return false;
+		}
+	}
+	return true;
+}
+
+bool dag_resolver::apply_plan () {
+	planned_ = false;
+	if (!plan_) return false;
+	if (!verify_plan()) {
+		plan_ = nullopt;
+		return false;
+	}
+	begin_graph();
+	auto && entries = plan_->entries_;
+	for (std::size_t i = 0; i < entries.size(); ++i) {
+		auto && rs = entries[i].requests;
+		for (std::size_t j = 0; j < rs.size(); ++j) {
+			begin_request(i,j);
+			for (auto p : rs[j].providers) do_resolve(i,j,p);
+		}
+	}
+	end_graph();
+	order_ = plan_->order_;
+	planned_ = true;
+	return true;
+}
+
+std::vector<construction_profile::duration::rep> dag_resolver::ranks () const {
+	//	The rank of a node is the time it takes to
+	//	fulfill plus the greatest rank of the nodes which
+	//	depend on it, i.e. the length of the longest path
+	//	from it to the end of construction
+	using rep = construction_profile::duration::rep;
+	auto n = nodes_.size();
+	std::vector<rep> retr(n,0);
+	std::vector<bool> known(n,false);
+	if (profile_) {
+		rep total(0);
+		std::size_t count(0);
+		for (std::size_t i = 0; i < n; ++i) {
+			auto d = profile_->find(nodes_[i].offer());
+			if (!d) continue;
+			retr[i] = std::max<rep>(d->count(),1);
+			known[i] = true;
+			total += retr[i];
+			++count;
+		}
+		//	Offers which have never been fulfilled are
+		//	assumed to be typical
+		rep estimate = (count == 0U) ? 1 : std::max<rep>(total / rep(count),1);
+		for (std::size_t i = 0; i < n; ++i) if (!known[i]) retr[i] = estimate;
+	} else {
+		std::fill(retr.begin(),retr.end(),1);
+	}
+	for (auto iter = order_.rbegin(); iter != order_.rend(); ++iter) {
+		auto i = *iter;
+		rep longest(0);
+		auto range = children(i);
+		for (; range.first != range.second; ++range.first) longest = std::max(longest,retr[*range.first]);
+		retr[i] += longest;
+	}
+	return retr;
+}
+
+void dag_resolver::create_concurrently () {
+	//	List scheduling:  Whenever a thread is free it
+	//	constructs the ready object of greatest rank,
+	//	breaking ties in favor of the earliest offer
+	auto r = ranks();
+	auto higher = [&] (std::size_t a, std::size_t b) noexcept {
+		if (r[a] != r[b]) return r[a] < r[b];
+		return a > b;
+	};
+	auto n = nodes_.size();
+	std::vector<std::size_t> pending(n);
+	std::vector<std::size_t> ready;
+	//	Nothing is allocated while the lock is held so
+	//	bookkeeping cannot throw
+	ready.reserve(n);
+	for (std::size_t i = 0; i < n; ++i) {
+		pending[i] = edge_offsets_[request_offsets_[i + 1]] - edge_offsets_[request_offsets_[i]];
+		if (pending[i] == 0U) ready.push_back(i);
+	}
+	std::make_heap(ready.begin(),ready.end(),higher);
+	objects_.reserve(n);
+	//	Becomes the order in which objects are actually
+	//	constructed which is also a topological order
+	order_.clear();
+	std::mutex m;
+	std::mutex events;
+	std::condition_variable cv;
+	std::exception_ptr ex;
+	auto work = [&] () noexcept {
+		std::unique_lock<std::mutex> l(m);
+		for (;;) {
+			cv.wait(l,[&] () noexcept {	return ex || !ready.empty() || (order_.size() == n);	});
+			if (ex || (order_.size() == n)) return;
+			std::pop_heap(ready.begin(),ready.end(),higher);
+			auto i = ready.back();
+			ready.pop_back();
+			l.unlock();
+			std::unique_ptr<object> obj;
+			try {
+				obj = do_create(i,&events);
+			} catch (...) {
+				l.lock();
+				if (!ex) ex = std::current_exception();
+				cv.notify_all();
+				return;
+			}
+			l.lock();
+			objects_.push_back(std::move(obj));
+			order_.push_back(i);
+			auto range = children(i);
+			for (; range.first != range.second; ++range.first) {
+				auto child = *range.first;
+				if (--pending[child] != 0U) continue;
+				ready.push_back(child);
+				std::push_heap(ready.begin(),ready.end(),higher);
+			}
+			cv.notify_all();
+		}
+	};
+	std::vector<std::thread> threads;
+	auto count = std::min(concurrency_,n);
+	try {
+		threads.reserve(count - 1U);
+		for (std::size_t i = 1; i < count; ++i) threads.emplace_back(work);
+	} catch (...) {
+		std::lock_guard<std::mutex> l(m);
+		ex = std::current_exception();
+		cv.notify_all();
+	}
+	work();
+	for (auto && t : threads) t.join();
+	if (ex) std::rethrow_exception(ex);
 }
 
 void dag_resolver::create () {
-	objects_.reserve(nodes_.size());
-	std::transform(nodes_.begin(),nodes_.end(),std::back_inserter(objects_),[&] (const auto & ptr) {
-		return this->do_create(*ptr);
-	});
+	if ((concurrency_ > 1U) && (nodes_.size() > 1U)) {
+		create_concurrently();
+		return;
+	}
+	objects_.reserve(order_.size());
+	for (auto i : order_) objects_.push_back(do_create(i));
 }
 
-dag_resolver::dag_resolver (offer_factory & of, resolver_observer * ro) : of_(of), ro_(ro) {	}
+dag_resolver::dag_resolver (offer_factory & of, resolver_observer * ro) : of_(&of), catalog_(nullptr), ro_(ro), stats_(nullptr), profile_(nullptr), concurrency_(1), planned_(false) {	}
+
+dag_resolver::dag_resolver (offer_factory & of, resolver_observer & ro) : of_(&of), catalog_(nullptr), ro_(&ro), stats_(nullptr), profile_(nullptr), concurrency_(1), planned_(false) {	}
 
-dag_resolver::dag_resolver (offer_factory & of, resolver_observer & ro) : of_(of), ro_(&ro) {	}
+dag_resolver::dag_resolver (const offer_catalog & catalog, resolver_observer * ro) : of_(nullptr), catalog_(&catalog), ro_(ro), stats_(nullptr), profile_(nullptr), concurrency_(1), planned_(false) {	}
+
+dag_resolver::dag_resolver (const offer_catalog & catalog, resolver_observer & ro) : of_(nullptr), catalog_(&catalog), ro_(&ro), stats_(nullptr), profile_(nullptr), concurrency_(1), planned_(false) {	}
 
 dag_resolver::~dag_resolver () noexcept {
 	clear();
 }
 
 void dag_resolver::clear () noexcept {
+	if (objects_.empty()) return;
+	resolver_statistics::timer t(stats_,resolver_statistics::phase::destroy);
 	//	This destroys objects in the reverse
 	//	of the order in which they were constructed)
 	while (!objects_.empty()) {
@@ -376,16 +727,125 @@ void dag_resolver::clear () noexcept {
 
 void dag_resolver::resolve () {
 	try {
+		using phase = resolver_statistics::phase;
 		clear();
-		get_offers();
-		create_graph();
-		check_graph();
-		topological_sort();
-		create();
+		{
+			resolver_statistics::timer t(stats_,phase::get_offers);
+			get_offers();
+		}
+		bool planned;
+		{
+			resolver_statistics::timer t(stats_,phase::create_graph);
+			planned = apply_plan();
+			if (!planned) create_graph();
+		}
+		if (!planned) {
+			unfulfilled_error::entries_type entries;
+			{
+				resolver_statistics::timer t(stats_,phase::check_graph);
+				check_graph(entries);
+			}
+			if (!entries.empty()) throw unfulfilled_error(std::move(entries));
+			not_a_dag_error::cycles_type cycles;
+			{
+				resolver_statistics::timer t(stats_,phase::topological_sort);
+				topological_sort(cycles);
+			}
+			if (!cycles.empty()) throw not_a_dag_error(std::move(cycles));
+		}
+		record_graph();
+		{
+			resolver_statistics::timer t(stats_,phase::create);
+			create();
+		}
+		record_critical_path();
+		record_profile();
 	} catch (...) {
 		clear();
 		throw;
 	}
 }
 
+dag_resolver::result dag_resolver::try_resolve () {
+	using phase = resolver_statistics::phase;
+	{
+		resolver_statistics::timer t(stats_,phase::get_offers);
+		get_offers();
+	}
+	{
+		resolver_statistics::timer t(stats_,phase::create_graph);
+		create_graph();
+	}
+	unfulfilled_error::entries_type entries;
+	{
+		resolver_statistics::timer t(stats_,phase::check_graph);
+		check_graph(entries);
+	}
+	not_a_dag_error::cycles_type cycles;
+	{
+		resolver_statistics::timer t(stats_,phase::topological_sort);
+		topological_sort(cycles);
+	}
+	record_graph();
+	return result(std::move(entries),std::move(cycles));
+}
+
+resolution_plan dag_resolver::plan () const {
+	if (objects_.size() != nodes_.size()) throw std::logic_error("module_loader::dag_resolver::plan requires a resolved dependency graph");
+	resolution_plan retr;
+	auto && entries = retr.entries_;
+	entries.resize(nodes_.size());
+	retr.order_ = order_;
+	for (std::size_t i = 0; i < nodes_.size(); ++i) {
+		auto && o = nodes_[i].offer();
+		auto && e = entries[i];
+		e.name = o.name();
+		e.type = o.type().name();
+		e.provides = provided_names(o);
+		auto && rs = o.requests();
+		e.requests.resize(rs.size());
+		for (std::size_t j = 0; j < rs.size(); ++j) {
+			auto && r = e.requests[j];
+			r.type = rs[j].type().name();
+			r.lower = rs[j].lower_bound();
+			r.upper = rs[j].upper_bound();
+			auto range = depends_on(i,j);
+			r.providers.assign(range.first,range.second);
+		}
+	}
+	return retr;
+}
+
+void dag_resolver::plan (resolution_plan p) {
+	plan_.emplace(std::move(p));
+}
+
+bool dag_resolver::planned () const noexcept {
+	return planned_;
+}
+
+void dag_resolver::statistics (resolver_statistics * s) noexcept {
+	stats_ = s;
+}
+
+resolver_statistics * dag_resolver::statistics () const noexcept {
+	return stats_;
+}
+
+void dag_resolver::concurrency (std::size_t n) noexcept {
+	concurrency_ = (n == 0U) ? 1U : n;
+}
+
+std::size_t dag_resolver::concurrency () const noexcept {
+	return concurrency_;
+}
+
+void dag_resolver::profile (construction_profile * p) noexcept {
+	profile_ = p;
+}
+
+construction_profile * dag_resolver::profile () const noexcept {
+	return profile_;
+}
+
 }
@@ -4,6 +4,7 @@
 #include <module_loader/shared_library_directory_entry_filter.hpp>
 #include <algorithm>
 #include <cctype>
+#include <chrono>
 #include <utility>
 
 namespace module_loader {
@@ -53,9 +54,9 @@ void directory_scanning_shared_library_factory::dispatch_end_directory () const
 	o_->on_end_directory(std::move(e));
 }
 
-void directory_scanning_shared_library_factory::dispatch_load (const boost::dll::shared_library & so) const {
+void directory_scanning_shared_library_factory::dispatch_load (const boost::dll::shared_library & so, std::chrono::steady_clock::duration duration) const {
 	if (!o_) return;
-	directory_scanning_shared_library_factory_observer::load_event e(so);
+	directory_scanning_shared_library_factory_observer::load_event e(so,duration);
 	o_->on_load(std::move(e));
 }
 
@@ -84,8 +85,9 @@ directory_scanning_shared_library_factory::directory_scanning_shared_library_fac
 
 boost::dll::shared_library directory_scanning_shared_library_factory::next () {
 	if (!next_library()) return boost::dll::shared_library{};
-	boost::dll::shared_library retr(dir_->path());
-	dispatch_load(retr);
+	auto begin = std::chrono::steady_clock::now();
+	auto retr = policy_.load(dir_->path());
+	dispatch_load(retr,std::chrono::steady_clock::now() - begin);
 	return retr;
 }
 
@@ -95,4 +97,12 @@ bool directory_scanning_shared_library_factory::add (boost::filesystem::path pat
 	return pair.second;
 }
 
+void directory_scanning_shared_library_factory::policy (load_policy policy) noexcept {
+	policy_ = policy;
+}
+
+const load_policy & directory_scanning_shared_library_factory::policy () const noexcept {
+	return policy_;
+}
+
 }
@@ -14,11 +14,21 @@ const boost::filesystem::path & directory_scanning_shared_library_factory_observ
 }
 
 directory_scanning_shared_library_factory_observer::load_event::load_event (boost::dll::shared_library so)
-	:	so_(std::move(so))
+	:	so_(std::move(so)),
+		duration_(std::chrono::steady_clock::duration::zero())
+{	}
+
+directory_scanning_shared_library_factory_observer::load_event::load_event (boost::dll::shared_library so, std::chrono::steady_clock::duration duration)
+	:	so_(std::move(so)),
+		duration_(duration)
 {	}
 
 const boost::dll::shared_library & directory_scanning_shared_library_factory_observer::load_event::shared_library () const noexcept {
 	return so_;
 }
 
+std::chrono::steady_clock::duration directory_scanning_shared_library_factory_observer::load_event::duration () const noexcept {
+	return duration_;
+}
+
 }
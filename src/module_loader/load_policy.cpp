@@ -0,0 +1,67 @@
+#include <boost/dll/shared_library.hpp>
+#include <boost/dll/shared_library_load_mode.hpp>
+#include <boost/filesystem.hpp>
+#include <module_loader/load_policy.hpp>
+#ifndef _WIN32
+#include <dlfcn.h>
+#endif
+
+namespace module_loader {
+
+load_policy::load_policy () noexcept
+	:	binding_(binding::lazy),
+		visibility_(visibility::local),
+		deep_bind_(false),
+		no_delete_(false)
+{	}
+
+void load_policy::bind (binding b) noexcept {
+	binding_ = b;
+}
+
+load_policy::binding load_policy::bind () const noexcept {
+	return binding_;
+}
+
+void load_policy::symbols (visibility v) noexcept {
+	visibility_ = v;
+}
+
+load_policy::visibility load_policy::symbols () const noexcept {
+	return visibility_;
+}
+
+void load_policy::deep_bind (bool deep_bind) noexcept {
+	deep_bind_ = deep_bind;
+}
+
+bool load_policy::deep_bind () const noexcept {
+	return deep_bind_;
+}
+
+void load_policy::no_delete (bool no_delete) noexcept {
+	no_delete_ = no_delete;
+}
+
+bool load_policy::no_delete () const noexcept {
+	return no_delete_;
+}
+
+boost::dll::load_mode::type load_policy::mode () const noexcept {
+	using boost::dll::load_mode::type;
+	auto retr = (binding_ == binding::now) ? boost::dll::load_mode::rtld_now : boost::dll::load_mode::rtld_lazy;
+	retr |= (visibility_ == visibility::global) ? boost::dll::load_mode::rtld_global : boost::dll::load_mode::rtld_local;
+	if (deep_bind_) retr |= boost::dll::load_mode::rtld_deepbind;
+	#ifdef RTLD_NODELETE
+	//	Boost.DLL has no enumerator for this but passes
+	//	unrecognized bits through to dlopen
+	if (no_delete_) retr |= static_cast<type>(RTLD_NODELETE);
+	#endif
+	return retr;
+}
+
+boost::dll::shared_library load_policy::load (const boost::filesystem::path & path) const {
+	return boost::dll::shared_library(path,mode());
+}
+
+}
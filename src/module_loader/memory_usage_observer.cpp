@@ -0,0 +1,213 @@
+#include <module_loader/memory_usage_observer.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <utility>
+#ifdef __GLIBC__
+#include <dlfcn.h>
+#include <link.h>
+#include <malloc.h>
+#endif
+
+namespace module_loader {
+
+memory_usage_observer::entry::entry (std::string name, std::size_t heap, std::size_t mapped) noexcept
+	:	name_(std::move(name)),
+		heap_(heap),
+		mapped_(mapped)
+{	}
+
+const std::string & memory_usage_observer::entry::name () const noexcept {
+	return name_;
+}
+
+std::size_t memory_usage_observer::entry::heap () const noexcept {
+	return heap_;
+}
+
+std::size_t memory_usage_observer::entry::mapped () const noexcept {
+	return mapped_;
+}
+
+std::size_t memory_usage_observer::entry::total () const noexcept {
+	return heap_ + mapped_;
+}
+
+namespace {
+
+std::size_t heap_since (std::size_t begin) noexcept {
+	//	Other frees may have happened meanwhile in which
+	//	case nothing can reasonably be attributed
+	auto end = memory_usage_observer::heap_in_use();
+	return (end > begin) ? (end - begin) : 0;
+}
+
+}
+
+template <typename Map>
+memory_usage_observer::entries_type memory_usage_observer::sorted (const Map & map) {
+	entries_type retr;
+	retr.reserve(map.size());
+	for (auto && pair : map) retr.push_back(pair.second);
+	std::sort(retr.begin(),retr.end(),[] (const entry & a, const entry & b) noexcept {
+		auto at = a.total();
+		auto bt = b.total();
+		if (at != bt) return at > bt;
+		return a.name() < b.name();
+	});
+	return retr;
+}
+
+memory_usage_observer::memory_usage_observer () : load_begin_(0) {	}
+
+void memory_usage_observer::on_resolve (resolve_event) {	}
+
+void memory_usage_observer::on_begin_create (begin_create_event event) {
+	auto id = std::this_thread::get_id();
+	bool overlapped = false;
+	for (auto iter = creating_.begin(); iter != creating_.end();) {
+		//	Each thread creates one object at a time so
+		//	a creation which began on this thread and never
+		//	ended must have thrown
+		if (iter->second.thread == id) {
+			iter = creating_.erase(iter);
+			continue;
+		}
+		iter->second.overlapped = true;
+		overlapped = true;
+		++iter;
+	}
+	auto && p = creating_[&event.offer()];
+	p = pending_create{event.offer().name(),0,id,overlapped};
+	//	Sampled last so that the above is not
+	//	attributed to the object
+	p.begin = heap_in_use();
+}
+
+void memory_usage_observer::on_create (create_event event) {
+	std::size_t heap(0);
+	std::string name;
+	auto iter = creating_.find(&event.offer());
+	if (iter == creating_.end()) {
+		name = event.offer().name();
+	} else {
+		if (!iter->second.overlapped) heap = heap_since(iter->second.begin);
+		name = std::move(iter->second.name);
+		creating_.erase(iter);
+	}
+	entry e(std::move(name),heap,0);
+	objects_.erase(&event.object());
+	objects_.emplace(&event.object(),std::move(e));
+}
+
+void memory_usage_observer::on_destroy (destroy_event event) {
+	//	Objects are never destroyed while others are
+	//	being created so any creation still pending
+	//	threw on a thread which has since finished
+	creating_.clear();
+	objects_.erase(&event.object());
+}
+
+void memory_usage_observer::on_begin_load (begin_load_event) {
+	load_begin_ = heap_in_use();
+}
+
+void memory_usage_observer::on_end_load (end_load_event event) {
+	auto heap = heap_since(load_begin_);
+	auto && so = event.shared_library();
+	auto name = so.location().string();
+	auto iter = libraries_.find(name);
+	if (iter == libraries_.end()) {
+		entry e(name,heap,mapped_size(so));
+		libraries_.emplace(std::move(name),std::move(e));
+		return;
+	}
+	auto && e = iter->second;
+	e = entry(e.name(),e.heap() + heap,e.mapped());
+}
+
+void memory_usage_observer::on_add (add_event) {	}
+
+memory_usage_observer::entries_type memory_usage_observer::objects () const {
+	return sorted(objects_);
+}
+
+memory_usage_observer::entries_type memory_usage_observer::libraries () const {
+	return sorted(libraries_);
+}
+
+static void report_entries (std::ostream & os, const char * title, const memory_usage_observer::entries_type & entries) {
+	os << title << " (" << entries.size() << "):";
+	for (auto && e : entries) {
+		os << "\n\t" << e.total() << " bytes (heap " << e.heap() << ", mapped " << e.mapped() << ") " << e.name();
+	}
+	os << '\n';
+}
+
+void memory_usage_observer::report (std::ostream & os) const {
+	report_entries(os,"Objects",objects());
+	report_entries(os,"Shared libraries",libraries());
+}
+
+std::size_t memory_usage_observer::heap_in_use () noexcept {
+	//	__GLIBC_PREREQ is only defined by glibc so it
+	//	must not be expanded unless __GLIBC__ is defined
+	#ifdef __GLIBC__
+	#if __GLIBC_PREREQ(2,33)
+	auto info = ::mallinfo2();
+	return info.uordblks + info.hblkhd;
+	#else
+	auto info = ::mallinfo();
+	return static_cast<unsigned int>(info.uordblks) + static_cast<unsigned int>(info.hblkhd);
+	#endif
+	#else
+	return 0;
+	#endif
+}
+
+#ifdef __GLIBC__
+namespace {
+
+class mapped_size_search {
+private:
+	const ::link_map * lm_;
+	std::size_t size_;
+public:
+	explicit mapped_size_search (const ::link_map & lm) noexcept : lm_(&lm), size_(0) {	}
+	static int callback (::dl_phdr_info * info, std::size_t, void * ptr) noexcept {
+		auto && self = *static_cast<mapped_size_search *>(ptr);
+		if (info->dlpi_addr != self.lm_->l_addr) return 0;
+		if (std::strcmp(info->dlpi_name,self.lm_->l_name) != 0) return 0;
+		for (std::size_t i = 0; i < info->dlpi_phnum; ++i) {
+			auto && phdr = info->dlpi_phdr[i];
+			if (phdr.p_type == PT_LOAD) self.size_ += phdr.p_memsz;
+		}
+		return 1;
+	}
+	std::size_t size () const noexcept {
+		return size_;
+	}
+};
+
+}
+#endif
+
+std::size_t memory_usage_observer::mapped_size (const boost::dll::shared_library & so) noexcept {
+	#ifdef __GLIBC__
+	if (!so) return 0;
+	::link_map * lm = nullptr;
+	if (::dlinfo(so.native(),RTLD_DI_LINKMAP,&lm) != 0) return 0;
+	if (!lm) return 0;
+	mapped_size_search search(*lm);
+	::dl_iterate_phdr(&mapped_size_search::callback,&search);
+	return search.size();
+	#else
+	(void)so;
+	return 0;
+	#endif
+}
+
+}
@@ -4,48 +4,48 @@
 #include <module_loader/not_a_dag_error.hpp>
 #include <algorithm>
 #include <cstddef>
-#include <sstream>
+#include <ostream>
 #include <stdexcept>
-#include <string>
 #include <utility>
 
 namespace module_loader {
 
-static std::string get_what (const not_a_dag_error::cycles_type & cycles) {
-	if (cycles.empty()) throw std::logic_error("Expected at least one cycle");
-	std::ostringstream ss;
-	ss << "Dependency graph not a directed acyclic graph (DAG) due to the following cycles:";
+void not_a_dag_error::format (std::ostream & os) const {
+	os << "Dependency graph not a directed acyclic graph (DAG) due to the following cycles:";
 	std::for_each(
 		boost::make_zip_iterator(
 			boost::make_tuple(
-				cycles.begin(),
+				cycles_.begin(),
 				boost::make_counting_iterator(std::size_t(0))
 			)
 		),
 		boost::make_zip_iterator(
 			boost::make_tuple(
-				cycles.end(),
-				boost::make_counting_iterator(cycles.size())
+				cycles_.end(),
+				boost::make_counting_iterator(cycles_.size())
 			)
 		),
 		[&] (const auto & tuple) {
 			auto && cycle = boost::get<0>(tuple);
-			if (cycle.empty()) throw std::logic_error("Empty cycle");
 			auto i = boost::get<1>(tuple);
-			ss << "\n#" << (i + 1) << ": ";
+			os << "\n#" << (i + 1) << ": ";
 			for (auto && ptr : cycle) {
-				ss << ptr->name() << " => ";
+				os << ptr->name() << " => ";
 			}
-			ss << cycle.front()->name();
+			os << cycle.front()->name();
 		}
 	);
-	return ss.str();
 }
 
 not_a_dag_error::not_a_dag_error (cycles_type cycles)
-	:	resolver_error(get_what(cycles)),
+	:	resolver_error(deferred_t{},"Dependency graph not a directed acyclic graph (DAG)"),
 		cycles_(std::move(cycles))
-{	}
+{
+	if (cycles_.empty()) throw std::logic_error("Expected at least one cycle");
+	for (auto && cycle : cycles_) {
+		if (cycle.empty()) throw std::logic_error("Empty cycle");
+	}
+}
 
 const not_a_dag_error::cycles_type & not_a_dag_error::cycles () const noexcept {
 	return cycles_;
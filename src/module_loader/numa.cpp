@@ -0,0 +1,113 @@
+#include <module_loader/numa.hpp>
+#include <module_loader/numa_offer.hpp>
+#include <module_loader/offer.hpp>
+#include <cstddef>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace module_loader {
+
+namespace {
+
+//	Parses the list format used by sysfs (e.g.
+//	"0-3,8-11")
+std::vector<std::size_t> read_list (const std::string & path) {
+	std::vector<std::size_t> retr;
+	std::ifstream stream(path);
+	std::string str;
+	if (!std::getline(stream,str)) return retr;
+	std::size_t pos = 0;
+	while (pos < str.size()) {
+		auto end = str.find(',',pos);
+		if (end == std::string::npos) end = str.size();
+		auto range = str.substr(pos,end - pos);
+		pos = end + 1;
+		if (range.empty()) continue;
+		try {
+			auto dash = range.find('-');
+			std::size_t first = std::stoul(range.substr(0,dash));
+			std::size_t last = (dash == std::string::npos) ? first : std::stoul(range.substr(dash + 1));
+			for (auto i = first; i <= last; ++i) retr.push_back(i);
+		} catch (...) {
+			return std::vector<std::size_t>{};
+		}
+	}
+	return retr;
+}
+
+#ifdef __linux__
+bool bind_to (const std::vector<std::size_t> & cpus) noexcept {
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	for (auto cpu : cpus) if (cpu < CPU_SETSIZE) CPU_SET(cpu,&set);
+	return ::pthread_setaffinity_np(::pthread_self(),sizeof(set),&set) == 0;
+}
+#else
+bool bind_to (const std::vector<std::size_t> &) noexcept {
+	return false;
+}
+#endif
+
+}
+
+std::vector<std::size_t> numa_nodes () {
+	#ifdef __linux__
+	auto retr = read_list("/sys/devices/system/node/online");
+	if (!retr.empty()) return retr;
+	#endif
+	return std::vector<std::size_t>{0};
+}
+
+std::vector<std::size_t> numa_cpus (std::size_t node) {
+	#ifdef __linux__
+	return read_list("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+	#else
+	(void)node;
+	return std::vector<std::size_t>{};
+	#endif
+}
+
+void run_on_numa_node (std::size_t node, const std::function<void ()> & func) {
+	auto cpus = numa_cpus(node);
+	if (cpus.empty()) {
+		func();
+		return;
+	}
+	std::exception_ptr ex;
+	bool bound = false;
+	std::thread t([&] () {
+		bound = bind_to(cpus);
+		if (!bound) return;
+		try {
+			func();
+		} catch (...) {
+			ex = std::current_exception();
+		}
+	});
+	t.join();
+	if (!bound) {
+		func();
+		return;
+	}
+	if (ex) std::rethrow_exception(ex);
+}
+
+std::unique_ptr<offer> make_numa_offer (std::unique_ptr<offer> inner, std::size_t node) {
+	return std::make_unique<numa_offer<std::unique_ptr<offer>>>(std::move(inner),node);
+}
+
+std::shared_ptr<offer> make_numa_offer (std::shared_ptr<offer> inner, std::size_t node) {
+	return std::make_shared<numa_offer<std::shared_ptr<offer>>>(std::move(inner),node);
+}
+
+}
@@ -0,0 +1,39 @@
+#include <module_loader/offer_catalog.hpp>
+#include <module_loader/provider_key.hpp>
+#include <cstddef>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+namespace module_loader {
+
+namespace {
+
+constexpr std::size_t batch_size = 64;
+
+}
+
+offer_catalog::offer_catalog (offer_factory & of) {
+	for (;;) {
+		auto n = of.next_batch(offers_,batch_size);
+		if (n != batch_size) break;
+	}
+	for (std::size_t i = 0; i < offers_.size(); ++i) {
+		for (auto && t : offers_[i]->provides()) providers_[t].push_back(i);
+	}
+	std::vector<std::pair<provider_key,std::size_t>> keyed;
+	for (auto && pair : providers_) {
+		auto && t = pair.first;
+		sort_providers(pair.second,[&] (std::size_t i) noexcept {	return find_request(*offers_[i],t);	},keyed);
+	}
+}
+
+const offer_catalog::offers_type & offer_catalog::offers () const noexcept {
+	return offers_;
+}
+
+const offer_catalog::providers_type & offer_catalog::providers () const noexcept {
+	return providers_;
+}
+
+}
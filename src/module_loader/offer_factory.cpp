@@ -1,7 +1,23 @@
 #include <module_loader/offer_factory.hpp>
+#include <cstddef>
+#include <utility>
 
 namespace module_loader {
 
 offer_factory::~offer_factory () noexcept {	}
 
+std::size_t offer_factory::next_batch (batch_type & batch, std::size_t max) {
+	std::size_t retr(0);
+	for (; retr != max; ++retr) {
+		auto ptr = next_shared();
+		if (!ptr) break;
+		batch.push_back(std::move(ptr));
+	}
+	return retr;
+}
+
+std::size_t offer_factory::size_hint () const noexcept {
+	return 0;
+}
+
 }
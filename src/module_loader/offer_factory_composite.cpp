@@ -1,5 +1,6 @@
 #include <module_loader/offer_factory.hpp>
 #include <module_loader/offer_factory_composite.hpp>
+#include <cstddef>
 #include <type_traits>
 
 namespace module_loader {
@@ -36,4 +37,23 @@ std::shared_ptr<offer> offer_factory_composite::next_shared () {
 	return next_impl<std::shared_ptr<offer>>(); 
 }
 
+std::size_t offer_factory_composite::next_batch (batch_type & batch, std::size_t max) {
+	std::size_t retr(0);
+	while (!fs_.empty() && (retr != max)) {
+		auto begin = fs_.begin();
+		auto want = max - retr;
+		auto got = (*begin)->next_batch(batch,want);
+		retr += got;
+		//	A short batch means that factory is exhausted
+		if (got != want) fs_.erase(begin);
+	}
+	return retr;
+}
+
+std::size_t offer_factory_composite::size_hint () const noexcept {
+	std::size_t retr(0);
+	for (auto ptr : fs_) retr += ptr->size_hint();
+	return retr;
+}
+
 }
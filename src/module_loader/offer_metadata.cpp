@@ -0,0 +1,340 @@
+#include <boost/filesystem.hpp>
+#include <module_loader/error.hpp>
+#include <module_loader/offer_metadata.hpp>
+#include <module_loader/request.hpp>
+#include <cctype>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#ifndef _WIN32
+#include <elf.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace module_loader {
+
+offer_metadata::offer_metadata (std::string name, provides_type provides, requests_type requests, bounds_type bounds)
+	:	name_(std::move(name)),
+		provides_(std::move(provides)),
+		requests_(std::move(requests)),
+		bounds_(std::move(bounds))
+{
+	if (bounds_.empty()) bounds_.assign(requests_.size(),bounds_type::value_type(1,1));
+	if (bounds_.size() != requests_.size()) throw std::invalid_argument("Each request must have bounds");
+}
+
+const std::string & offer_metadata::name () const noexcept {
+	return name_;
+}
+
+const offer_metadata::provides_type & offer_metadata::provides () const noexcept {
+	return provides_;
+}
+
+const offer_metadata::requests_type & offer_metadata::requests () const noexcept {
+	return requests_;
+}
+
+const offer_metadata::bounds_type & offer_metadata::bounds () const noexcept {
+	return bounds_;
+}
+
+namespace {
+
+[[noreturn]]
+void malformed (const boost::filesystem::path & path) {
+	std::string what("Malformed ELF file ");
+	what += path.string();
+	throw error(what);
+}
+
+bool is_identifier (char c) noexcept {
+	return std::isalnum(static_cast<unsigned char>(c)) || (c == '_');
+}
+
+bool ends_with_word (const std::string & str, const char * word) {
+	auto len = std::strlen(word);
+	if (str.size() < len) return false;
+	auto pos = str.size() - len;
+	if (str.compare(pos,len,word) != 0) return false;
+	return (pos == 0) || !is_identifier(str[pos - 1U]);
+}
+
+//	Determines whether a scope resolution operator
+//	which follows what has been normalized so far
+//	qualifies a name by the global scope
+bool global_scope (const std::string & str, bool space) {
+	if (str.empty()) return true;
+	auto c = str.back();
+	if ((c == '<') || (c == ',') || (c == '(')) return true;
+	//	Otherwise only a cv-qualifier may be followed by
+	//	such a name (e.g. "const ::std::string")
+	return space && (ends_with_word(str,"const") || ends_with_word(str,"volatile"));
+}
+
+//	Whitespace is kept only where it separates two
+//	identifiers or keywords (e.g. "unsigned int") and
+//	global scope qualifiers are removed so that
+//	different spellings of the same type compare equal
+std::string normalize (const char * begin, const char * end) {
+	std::string retr;
+	bool space = false;
+	for (; begin != end; ++begin) {
+		auto c = *begin;
+		if (std::isspace(static_cast<unsigned char>(c))) {
+			space = true;
+			continue;
+		}
+		if ((c == ':') && ((end - begin) > 1) && (begin[1] == ':') && global_scope(retr,space)) {
+			++begin;
+			continue;
+		}
+		if (space && !retr.empty() && is_identifier(retr.back()) && is_identifier(c)) retr.push_back(' ');
+		space = false;
+		retr.push_back(c);
+	}
+	return retr;
+}
+
+std::string normalize (const std::string & str) {
+	return normalize(str.data(),str.data() + str.size());
+}
+
+//	Splits a stringized list on the commas which
+//	separate its elements, ignoring those within
+//	template argument lists and parentheses
+std::vector<std::string> split (const std::string & str) {
+	std::vector<std::string> retr;
+	std::size_t depth(0);
+	auto begin = str.data();
+	auto end = begin + str.size();
+	auto start = begin;
+	for (auto iter = begin; iter != end; ++iter) {
+		switch (*iter) {
+		case '<':
+		case '(':
+			++depth;
+			break;
+		case '>':
+		case ')':
+			if (depth != 0) --depth;
+			break;
+		case ',':
+			if (depth != 0) break;
+			retr.push_back(normalize(start,iter));
+			start = iter + 1;
+			break;
+		default:
+			break;
+		}
+	}
+	auto last = normalize(start,end);
+	if (!last.empty() || !retr.empty()) retr.push_back(std::move(last));
+	return retr;
+}
+
+//	Removes the parentheses around a list, if any
+bool unwrap (std::string & str) {
+	if ((str.size() < 2U) || (str.front() != '(') || (str.back() != ')')) return false;
+	str = str.substr(1,str.size() - 2U);
+	return true;
+}
+
+std::size_t parse_bound (const std::string & str, const boost::filesystem::path & path) {
+	if (str == "*") return request::infinity;
+	if (str.empty() || (str.size() > 19U)) malformed(path);
+	std::size_t retr(0);
+	for (auto c : str) {
+		if ((c < '0') || (c > '9')) malformed(path);
+		retr = (retr * 10U) + static_cast<std::size_t>(c - '0');
+	}
+	return retr;
+}
+
+offer_metadata::bounds_type parse_bounds (std::string str, std::size_t requests, const boost::filesystem::path & path) {
+	str = normalize(str);
+	if (!unwrap(str)) malformed(path);
+	offer_metadata::bounds_type retr;
+	for (auto && bound : split(str)) {
+		auto colon = bound.find(':');
+		if (colon == std::string::npos) malformed(path);
+		auto lower = parse_bound(bound.substr(0,colon),path);
+		auto upper = parse_bound(bound.substr(colon + 1U),path);
+		if (lower > upper) malformed(path);
+		retr.emplace_back(lower,upper);
+	}
+	if (!retr.empty() && (retr.size() != requests)) malformed(path);
+	return retr;
+}
+
+offer_metadata::provides_type parse_provides (std::string str) {
+	str = normalize(str);
+	if (unwrap(str)) return split(str);
+	return offer_metadata::provides_type{std::move(str)};
+}
+
+std::vector<offer_metadata> parse (const char * begin, const char * end, const boost::filesystem::path & path) {
+	std::vector<offer_metadata> retr;
+	auto field = [&] () {
+		auto nul = static_cast<const char *>(std::memchr(begin,0,end - begin));
+		if (!nul) malformed(path);
+		std::string retr(begin,nul);
+		begin = nul + 1;
+		return retr;
+	};
+	while (begin != end) {
+		//	Records may be separated by padding
+		if (*begin == '\0') {
+			++begin;
+			continue;
+		}
+		if (*begin != '\x02') malformed(path);
+		++begin;
+		auto name = field();
+		auto provides = parse_provides(field());
+		auto requests = split(field());
+		auto bounds = parse_bounds(field(),requests.size(),path);
+		retr.emplace_back(std::move(name),std::move(provides),std::move(requests),std::move(bounds));
+	}
+	return retr;
+}
+
+#ifndef _WIN32
+class mapping {
+private:
+	void * ptr_;
+	std::size_t size_;
+public:
+	mapping (void * ptr, std::size_t size) noexcept : ptr_(ptr), size_(size) {	}
+	mapping (const mapping &) = delete;
+	mapping & operator = (const mapping &) = delete;
+	~mapping () noexcept {
+		if (ptr_ != MAP_FAILED) ::munmap(ptr_,size_);
+	}
+	const char * data () const noexcept {
+		return static_cast<const char *>(ptr_);
+	}
+	std::size_t size () const noexcept {
+		return size_;
+	}
+};
+
+template <typename Ehdr, typename Shdr>
+std::vector<offer_metadata> read_elf (const mapping & m, const boost::filesystem::path & path) {
+	auto data = m.data();
+	auto size = m.size();
+	if (size < sizeof(Ehdr)) malformed(path);
+	Ehdr ehdr;
+	std::memcpy(&ehdr,data,sizeof(ehdr));
+	if ((ehdr.e_shoff == 0) || (ehdr.e_shnum == 0)) return {};
+	if (ehdr.e_shentsize != sizeof(Shdr)) malformed(path);
+	if ((ehdr.e_shoff > size) || (((size - ehdr.e_shoff) / sizeof(Shdr)) < ehdr.e_shnum)) malformed(path);
+	if (ehdr.e_shstrndx >= ehdr.e_shnum) malformed(path);
+	auto section = [&] (std::size_t i) {
+		Shdr shdr;
+		std::memcpy(&shdr,data + ehdr.e_shoff + (i * sizeof(Shdr)),sizeof(shdr));
+		return shdr;
+	};
+	auto strtab = section(ehdr.e_shstrndx);
+	if ((strtab.sh_offset > size) || (strtab.sh_size > (size - strtab.sh_offset))) malformed(path);
+	auto names = data + strtab.sh_offset;
+	constexpr std::size_t name_size = sizeof(MODULE_LOADER_OFFER_METADATA_SECTION);
+	for (std::size_t i = 0; i < ehdr.e_shnum; ++i) {
+		auto shdr = section(i);
+		if ((shdr.sh_name > strtab.sh_size) || ((strtab.sh_size - shdr.sh_name) < name_size)) continue;
+		if (std::memcmp(names + shdr.sh_name,MODULE_LOADER_OFFER_METADATA_SECTION,name_size) != 0) continue;
+		if (shdr.sh_type == SHT_NOBITS) return {};
+		if ((shdr.sh_offset > size) || (shdr.sh_size > (size - shdr.sh_offset))) malformed(path);
+		auto begin = data + shdr.sh_offset;
+		return parse(begin,begin + shdr.sh_size,path);
+	}
+	return {};
+}
+#endif
+
+}
+
+#ifdef _WIN32
+std::vector<offer_metadata> read_offer_metadata (const boost::filesystem::path &) {
+	return {};
+}
+#else
+std::vector<offer_metadata> read_offer_metadata (const boost::filesystem::path & path) {
+	auto fd = ::open(path.c_str(),O_RDONLY | O_CLOEXEC);
+	if (fd == -1) {
+		std::string what("Could not open ");
+		what += path.string();
+		throw error(what);
+	}
+	struct stat s;
+	auto result = ::fstat(fd,&s);
+	if ((result != 0) || (s.st_size < EI_NIDENT)) {
+		::close(fd);
+		if (result != 0) {
+			std::string what("Could not stat ");
+			what += path.string();
+			throw error(what);
+		}
+		return {};
+	}
+	auto size = static_cast<std::size_t>(s.st_size);
+	mapping m(::mmap(nullptr,size,PROT_READ,MAP_PRIVATE,fd,0),size);
+	::close(fd);
+	if (m.data() == MAP_FAILED) {
+		std::string what("Could not map ");
+		what += path.string();
+		throw error(what);
+	}
+	auto ident = reinterpret_cast<const unsigned char *>(m.data());
+	if (std::memcmp(ident,ELFMAG,SELFMAG) != 0) return {};
+	//	Only files matching the native byte order could
+	//	be loaded anyway
+	#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+	if (ident[EI_DATA] != ELFDATA2MSB) return {};
+	#else
+	if (ident[EI_DATA] != ELFDATA2LSB) return {};
+	#endif
+	if (ident[EI_CLASS] == ELFCLASS64) return read_elf<Elf64_Ehdr,Elf64_Shdr>(m,path);
+	if (ident[EI_CLASS] == ELFCLASS32) return read_elf<Elf32_Ehdr,Elf32_Shdr>(m,path);
+	return {};
+}
+#endif
+
+std::set<boost::filesystem::path> required_libraries (const library_metadata & libraries, const std::vector<std::string> & requests) {
+	std::set<boost::filesystem::path> retr;
+	std::unordered_set<std::string> seen;
+	std::deque<std::string> pending;
+	for (auto && r : requests) pending.push_back(normalize(r));
+	while (!pending.empty()) {
+		auto type = std::move(pending.front());
+		pending.pop_front();
+		if (!seen.insert(type).second) continue;
+		for (auto && pair : libraries) {
+			auto && offers = pair.second;
+			bool provides = false;
+			for (auto && o : offers) for (auto && t : o.provides()) if (normalize(t) == type) provides = true;
+			if (!provides || !retr.insert(pair.first).second) continue;
+			//	Loading a shared library yields all its offers
+			//	so each of their requests with a nonzero lower
+			//	bound must be fulfilled
+			for (auto && o : offers) {
+				auto && rs = o.requests();
+				for (std::size_t i = 0; i < rs.size(); ++i) {
+					if (o.bounds()[i].first != 0U) pending.push_back(normalize(rs[i]));
+				}
+			}
+		}
+	}
+	return retr;
+}
+
+}
@@ -0,0 +1,19 @@
+#include <module_loader/offer.hpp>
+#include <module_loader/provider_key.hpp>
+#include <module_loader/request.hpp>
+#include <algorithm>
+#include <typeindex>
+
+namespace module_loader {
+
+const request * find_request (const offer & o, const std::type_index & ti) noexcept {
+	auto && rs = o.requests();
+	auto end = rs.end();
+	auto iter = std::find_if(rs.begin(),end,[&] (const auto & r) noexcept {
+		return std::type_index(r.type()) == ti;
+	});
+	if (iter == end) return nullptr;
+	return &*iter;
+}
+
+}
@@ -1,4 +1,6 @@
 #include <module_loader/queue_offer_factory.hpp>
+#include <algorithm>
+#include <cstddef>
 #include <utility>
 
 namespace module_loader {
@@ -20,4 +22,18 @@ std::shared_ptr<offer> queue_offer_factory::next_shared () {
 	return std::shared_ptr<offer>(ptr.release());
 }
 
+std::size_t queue_offer_factory::next_batch (batch_type & batch, std::size_t max) {
+	auto n = std::min(max,q_.size());
+	batch.reserve(batch.size() + n);
+	auto begin = q_.begin();
+	auto end = begin + n;
+	for (auto iter = begin; iter != end; ++iter) batch.emplace_back(std::move(*iter));
+	q_.erase(begin,end);
+	return n;
+}
+
+std::size_t queue_offer_factory::size_hint () const noexcept {
+	return q_.size();
+}
+
 }
@@ -3,10 +3,16 @@
 
 namespace module_loader {
 
+queue_shared_library_factory::queue_shared_library_factory (load_policy policy) noexcept : policy_(policy) {	}
+
 void queue_shared_library_factory::add (boost::dll::shared_library so) {
 	q_.push_back(std::move(so));
 }
 
+void queue_shared_library_factory::add (const boost::filesystem::path & path) {
+	add(policy_.load(path));
+}
+
 boost::dll::shared_library queue_shared_library_factory::next () {
 	if (q_.empty()) return boost::dll::shared_library{};
 	auto retr = std::move(q_.front());
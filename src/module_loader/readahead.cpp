@@ -0,0 +1,68 @@
+#include <boost/filesystem.hpp>
+#include <module_loader/readahead.hpp>
+#include <cstddef>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace module_loader {
+
+#ifdef _WIN32
+bool readahead (const boost::filesystem::path &, bool) noexcept {
+	return false;
+}
+#else
+namespace {
+
+class file_descriptor {
+private:
+	int fd_;
+public:
+	explicit file_descriptor (int fd) noexcept : fd_(fd) {	}
+	file_descriptor (const file_descriptor &) = delete;
+	file_descriptor & operator = (const file_descriptor &) = delete;
+	~file_descriptor () noexcept {
+		if (fd_ != -1) ::close(fd_);
+	}
+	int get () const noexcept {
+		return fd_;
+	}
+};
+
+void populate (int fd) noexcept {
+	struct stat s;
+	if (::fstat(fd,&s) != 0) return;
+	if (s.st_size <= 0) return;
+	int flags = MAP_PRIVATE;
+	#ifdef MAP_POPULATE
+	flags |= MAP_POPULATE;
+	#endif
+	auto size = static_cast<std::size_t>(s.st_size);
+	auto ptr = ::mmap(nullptr,size,PROT_READ,flags,fd,0);
+	if (ptr == MAP_FAILED) return;
+	#ifndef MAP_POPULATE
+	//	Touch each page by hand
+	auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+	auto begin = static_cast<const volatile char *>(ptr);
+	for (std::size_t i = 0; i < size; i += page) (void)begin[i];
+	#endif
+	::munmap(ptr,size);
+}
+
+}
+
+bool readahead (const boost::filesystem::path & path, bool populate) noexcept {
+	file_descriptor fd(::open(path.c_str(),O_RDONLY | O_CLOEXEC));
+	if (fd.get() == -1) return false;
+	#ifdef POSIX_FADV_WILLNEED
+	if (::posix_fadvise(fd.get(),0,0,POSIX_FADV_WILLNEED) != 0) return false;
+	#endif
+	if (populate) module_loader::populate(fd.get());
+	return true;
+}
+#endif
+
+}
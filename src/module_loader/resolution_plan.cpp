@@ -0,0 +1,74 @@
+#include "binary_io.hpp"
+#include <module_loader/resolution_plan.hpp>
+#include <cstddef>
+#include <istream>
+#include <ostream>
+
+namespace module_loader {
+
+namespace {
+
+constexpr char magic [] = {'M','L','P','L','A','N','0','2'};
+constexpr const char * malformed = "Malformed resolution plan";
+
+}
+
+std::size_t resolution_plan::size () const noexcept {
+	return entries_.size();
+}
+
+void resolution_plan::write (std::ostream & os) const {
+	detail::binary_writer w(os);
+	w.magic(magic);
+	w.integer(entries_.size());
+	for (auto && e : entries_) {
+		w.string(e.name);
+		w.string(e.type);
+		w.integer(e.provides.size());
+		for (auto && t : e.provides) w.string(t);
+		w.integer(e.requests.size());
+		for (auto && r : e.requests) {
+			w.string(r.type);
+			w.integer(r.lower);
+			w.integer(r.upper);
+			w.integer(r.providers.size());
+			for (auto i : r.providers) w.integer(i);
+		}
+	}
+	for (auto i : order_) w.integer(i);
+}
+
+resolution_plan resolution_plan::read (std::istream & is) {
+	detail::binary_reader r(is,malformed);
+	using reader = detail::binary_reader;
+	r.magic(magic);
+	resolution_plan retr;
+	auto n = r.size();
+	retr.entries_.reserve(reader::reserve(n));
+	for (std::size_t i = 0; i < n; ++i) {
+		retr.entries_.emplace_back();
+		auto && e = retr.entries_.back();
+		e.name = r.string();
+		e.type = r.string();
+		auto provides = r.size();
+		e.provides.reserve(reader::reserve(provides));
+		for (std::size_t j = 0; j < provides; ++j) e.provides.push_back(r.string());
+		auto requests = r.size();
+		e.requests.reserve(reader::reserve(requests));
+		for (std::size_t j = 0; j < requests; ++j) {
+			e.requests.emplace_back();
+			auto && req = e.requests.back();
+			req.type = r.string();
+			req.lower = r.size();
+			req.upper = r.size();
+			auto providers = r.size();
+			req.providers.reserve(reader::reserve(providers));
+			for (std::size_t k = 0; k < providers; ++k) req.providers.push_back(r.size());
+		}
+	}
+	retr.order_.reserve(n);
+	for (std::size_t i = 0; i < n; ++i) retr.order_.push_back(r.size());
+	return retr;
+}
+
+}
@@ -0,0 +1,46 @@
+#include <module_loader/resolver_error.hpp>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+namespace module_loader {
+
+//	Shared between copies of the exception object
+//	so that the message is only generated once
+class resolver_error::message {
+public:
+	std::once_flag flag;
+	std::string str;
+};
+
+resolver_error::resolver_error (deferred_t tag, const char * summary)
+	:	error(summary),
+		message_(std::make_shared<message>())
+{
+	(void)tag;
+}
+
+void resolver_error::format (std::ostream & os) const {
+	os << error::what();
+}
+
+const char * resolver_error::what () const noexcept {
+	if (!message_) return error::what();
+	auto && m = *message_;
+	try {
+		std::call_once(m.flag,[&] () {
+			std::ostringstream ss;
+			format(ss);
+			m.str = ss.str();
+		});
+	} catch (...) {
+		//	Fall back to the summary, a subsequent call
+		//	will try again
+		return error::what();
+	}
+	return m.str.c_str();
+}
+
+}
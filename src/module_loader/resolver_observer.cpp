@@ -22,6 +22,16 @@ const request & resolver_observer::resolve_event::request () const noexcept {
 	return *request_;
 }
 
+resolver_observer::begin_create_event::begin_create_event (const module_loader::offer & offer) noexcept
+	:	offer_(&offer)
+{	}
+
+const offer & resolver_observer::begin_create_event::offer () const noexcept {
+	return *offer_;
+}
+
+void resolver_observer::on_begin_create (begin_create_event) {	}
+
 resolver_observer::create_event::create_event (const module_loader::offer & offer, const module_loader::object & object) noexcept
 	:	offer_(&offer),
 		object_(&object)
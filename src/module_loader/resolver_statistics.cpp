@@ -0,0 +1,112 @@
+#include <module_loader/memory_usage_observer.hpp>
+#include <module_loader/resolver_statistics.hpp>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+
+namespace module_loader {
+
+namespace {
+
+std::size_t index (resolver_statistics::phase p) noexcept {
+	return static_cast<std::size_t>(p);
+}
+
+}
+
+resolver_statistics::timer::timer (resolver_statistics * s, phase p) noexcept
+	:	s_(s),
+		p_(p)
+{
+	if (!s_) return;
+	heap_ = memory_usage_observer::heap_in_use();
+	begin_ = std::chrono::steady_clock::now();
+}
+
+resolver_statistics::timer::~timer () noexcept {
+	if (!s_) return;
+	auto elapsed = std::chrono::steady_clock::now() - begin_;
+	auto heap = memory_usage_observer::heap_in_use();
+	auto i = index(p_);
+	s_->durations_[i].fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),std::memory_order_relaxed);
+	s_->allocated_[i].fetch_add(static_cast<long long>(heap) - static_cast<long long>(heap_),std::memory_order_relaxed);
+}
+
+resolver_statistics::resolver_statistics () noexcept {
+	reset();
+}
+
+void resolver_statistics::clear_graph () noexcept {
+	nodes_.store(0,std::memory_order_relaxed);
+	edges_.store(0,std::memory_order_relaxed);
+	types_.store(0,std::memory_order_relaxed);
+	max_fan_in_.store(0,std::memory_order_relaxed);
+	max_fan_out_.store(0,std::memory_order_relaxed);
+	depth_.store(0,std::memory_order_relaxed);
+	critical_path_.store(0,std::memory_order_relaxed);
+	for (auto && a : providers_) a.store(0,std::memory_order_relaxed);
+}
+
+void resolver_statistics::add_providers (std::size_t n) noexcept {
+	assert(n != 0U);
+	std::size_t bucket = 0;
+	while ((n >>= 1U) != 0U) ++bucket;
+	if (bucket >= buckets) bucket = buckets - 1U;
+	providers_[bucket].fetch_add(1,std::memory_order_relaxed);
+	types_.fetch_add(1,std::memory_order_relaxed);
+}
+
+void resolver_statistics::reset () noexcept {
+	clear_graph();
+	for (auto && a : durations_) a.store(0,std::memory_order_relaxed);
+	for (auto && a : allocated_) a.store(0,std::memory_order_relaxed);
+	resolutions_.store(0,std::memory_order_relaxed);
+}
+
+std::size_t resolver_statistics::resolutions () const noexcept {
+	return resolutions_.load(std::memory_order_relaxed);
+}
+
+std::size_t resolver_statistics::nodes () const noexcept {
+	return nodes_.load(std::memory_order_relaxed);
+}
+
+std::size_t resolver_statistics::edges () const noexcept {
+	return edges_.load(std::memory_order_relaxed);
+}
+
+std::size_t resolver_statistics::types () const noexcept {
+	return types_.load(std::memory_order_relaxed);
+}
+
+std::size_t resolver_statistics::max_fan_in () const noexcept {
+	return max_fan_in_.load(std::memory_order_relaxed);
+}
+
+std::size_t resolver_statistics::max_fan_out () const noexcept {
+	return max_fan_out_.load(std::memory_order_relaxed);
+}
+
+std::size_t resolver_statistics::depth () const noexcept {
+	return depth_.load(std::memory_order_relaxed);
+}
+
+std::chrono::nanoseconds resolver_statistics::critical_path () const noexcept {
+	return std::chrono::nanoseconds(critical_path_.load(std::memory_order_relaxed));
+}
+
+std::size_t resolver_statistics::providers (std::size_t bucket) const noexcept {
+	assert(bucket < buckets);
+	return providers_[bucket].load(std::memory_order_relaxed);
+}
+
+std::chrono::nanoseconds resolver_statistics::duration (phase p) const noexcept {
+	return std::chrono::nanoseconds(durations_[index(p)].load(std::memory_order_relaxed));
+}
+
+long long resolver_statistics::allocated (phase p) const noexcept {
+	return allocated_[index(p)].load(std::memory_order_relaxed);
+}
+
+}
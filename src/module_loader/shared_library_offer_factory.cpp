@@ -4,13 +4,17 @@
 #include <module_loader/offer_decorator.hpp>
 #include <module_loader/shared_library_offer_factory.hpp>
 #include <module_loader/type_name.hpp>
+#include <algorithm>
+#include <cstddef>
 #include <exception>
+#include <future>
 #include <memory>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <typeinfo>
 #include <utility>
+#include <vector>
 
 namespace module_loader {
 
@@ -107,14 +111,88 @@ public:
 
 }
 
+thread_local shared_library_offer_factory::load_context * shared_library_offer_factory::context_ = nullptr;
+
+void shared_library_offer_factory::invoke (load_context & ctx) {
+	auto fn = ctx.so.get<void (shared_library_offer_factory &)>(name_);
+	if (!ctx.added) dispatch_begin_load(ctx.so);
+	ctx.prev = context_;
+	context_ = &ctx;
+	try {
+		guard([&] () {	fn(*this);	},ctx.so);
+	} catch (...) {
+		context_ = ctx.prev;
+		throw;
+	}
+	context_ = ctx.prev;
+	if (!ctx.added) dispatch_end_load(ctx.so);
+}
+
+void shared_library_offer_factory::collect (load_context & ctx) {
+	for (auto && ptr : ctx.offers) offers_.push_back(std::move(ptr));
+	ctx.offers.clear();
+}
+
+bool shared_library_offer_factory::load_sequentially () {
+	load_context ctx{this,slf_.next(),{},nullptr,nullptr};
+	if (!ctx.so) return false;
+	try {
+		invoke(ctx);
+	} catch (...) {
+		//	Offers added before the load handler threw
+		//	are yielded by subsequent calls
+		collect(ctx);
+		throw;
+	}
+	collect(ctx);
+	return true;
+}
+
+bool shared_library_offer_factory::load_concurrently () {
+	class task {
+	public:
+		load_context ctx;
+		std::vector<const offer *> added;
+		std::future<void> future;
+	};
+	std::deque<task> tasks;
+	for (std::size_t i = 0; i < concurrency_; ++i) {
+		auto so = slf_.next();
+		if (!so) break;
+		tasks.emplace_back();
+		auto && t = tasks.back();
+		t.ctx = load_context{this,std::move(so),{},&t.added,nullptr};
+	}
+	if (tasks.empty()) return false;
+	//	Should this throw the destructors of the futures
+	//	already obtained wait for their tasks to finish
+	for (auto && t : tasks) t.future = std::async(std::launch::async,[this,&t] () {	invoke(t.ctx);	});
+	for (auto && t : tasks) t.future.wait();
+	//	Every shared library in the wave has been loaded
+	//	so the offers of each are kept whether or not
+	//	another's load handler threw, just as they would
+	//	be had they been loaded one at a time
+	std::exception_ptr ex;
+	for (auto && t : tasks) {
+		bool failed = false;
+		try {
+			t.future.get();
+		} catch (...) {
+			if (!ex) ex = std::current_exception();
+			failed = true;
+		}
+		dispatch_begin_load(t.ctx.so);
+		for (auto ptr : t.added) dispatch_add(t.ctx.so,*ptr);
+		if (!failed) dispatch_end_load(t.ctx.so);
+		collect(t.ctx);
+	}
+	if (ex) std::rethrow_exception(ex);
+	return true;
+}
+
 bool shared_library_offer_factory::get_offers () {
 	while (offers_.empty()) {
-		curr_ = slf_.next();
-		if (!curr_) return false;
-		auto fn = curr_.get<void (shared_library_offer_factory &)>(name_);
-		dispatch_begin_load();
-		guard([&] () {	fn(*this);	},curr_);
-		dispatch_end_load();
+		if (!((concurrency_ > 1U) ? load_concurrently() : load_sequentially())) return false;
 	}
 	return true;
 }
@@ -126,25 +204,41 @@ std::unique_ptr<offer> shared_library_offer_factory::next_impl () {
 	return retr;
 }
 
-void shared_library_offer_factory::check_add () const {
-	if (!next_active_) throw std::logic_error("Do not call shared_library_offer_factory::add except from within shared_library_offer_factory::next or ::next_shared");
+std::size_t shared_library_offer_factory::next_batch_impl (batch_type & batch, std::size_t max) {
+	std::size_t retr(0);
+	while ((retr != max) && get_offers()) {
+		auto n = std::min(max - retr,offers_.size());
+		auto begin = offers_.begin();
+		auto end = begin + n;
+		for (auto iter = begin; iter != end; ++iter) batch.emplace_back(std::move(*iter));
+		offers_.erase(begin,end);
+		retr += n;
+	}
+	return retr;
+}
+
+shared_library_offer_factory::load_context & shared_library_offer_factory::context () const {
+	//	Nested load handlers of other factories may
+	//	be executing on this thread
+	for (auto ptr = context_; ptr; ptr = ptr->prev) if (ptr->owner == this) return *ptr;
+	throw std::logic_error("Do not call shared_library_offer_factory::add except from within a load handler invoked by that shared_library_offer_factory");
 }
 
-void shared_library_offer_factory::dispatch_add (const offer & o) {
+void shared_library_offer_factory::dispatch_add (const boost::dll::shared_library & so, const offer & o) {
 	if (!o_) return;
-	shared_library_offer_factory_observer::add_event event(curr_,o);
+	shared_library_offer_factory_observer::add_event event(so,o);
 	o_->on_add(std::move(event));
 }
 
-void shared_library_offer_factory::dispatch_begin_load () {
+void shared_library_offer_factory::dispatch_begin_load (const boost::dll::shared_library & so) {
 	if (!o_) return;
-	shared_library_offer_factory_observer::begin_load_event event(curr_);
+	shared_library_offer_factory_observer::begin_load_event event(so);
 	o_->on_begin_load(std::move(event));
 }
 
-void shared_library_offer_factory::dispatch_end_load () {
+void shared_library_offer_factory::dispatch_end_load (const boost::dll::shared_library & so) {
 	if (!o_) return;
-	shared_library_offer_factory_observer::end_load_event event(curr_);
+	shared_library_offer_factory_observer::end_load_event event(so);
 	o_->on_end_load(std::move(event));
 }
 
@@ -171,7 +265,7 @@ shared_library_offer_factory::shared_library_offer_factory (shared_library_facto
 	:	slf_(slf),
 		o_(nullptr),
 		name_("load"),
-		next_active_(false)
+		concurrency_(1)
 {	}
 
 shared_library_offer_factory::shared_library_offer_factory (shared_library_factory & slf, shared_library_offer_factory_observer & o)
@@ -181,16 +275,7 @@ shared_library_offer_factory::shared_library_offer_factory (shared_library_facto
 }
 
 std::unique_ptr<offer> shared_library_offer_factory::next () {
-	std::unique_ptr<offer> retr;
-	next_active_ = true;
-	try {
-		retr = next_impl();
-	} catch (...) {
-		next_active_ = false;
-		throw;
-	}
-	next_active_ = false;
-	return retr;
+	return next_impl();
 }
 
 std::shared_ptr<offer> shared_library_offer_factory::next_shared () {
@@ -199,16 +284,36 @@ std::shared_ptr<offer> shared_library_offer_factory::next_shared () {
 	return std::shared_ptr<offer>(ptr.release());
 }
 
+std::size_t shared_library_offer_factory::next_batch (batch_type & batch, std::size_t max) {
+	return next_batch_impl(batch,max);
+}
+
+std::size_t shared_library_offer_factory::size_hint () const noexcept {
+	return offers_.size();
+}
+
 void shared_library_offer_factory::add (std::unique_ptr<offer> o) {
-	check_add();
-	dispatch_add(*o);
-	offers_.push_back(std::make_unique<offer_wrapper<std::unique_ptr<offer>>>(curr_,std::move(o)));
+	auto && ctx = context();
+	auto && ref = *o;
+	if (!ctx.added) dispatch_add(ctx.so,ref);
+	ctx.offers.push_back(std::make_unique<offer_wrapper<std::unique_ptr<offer>>>(ctx.so,std::move(o)));
+	if (ctx.added) ctx.added->push_back(&ref);
 }
 
 void shared_library_offer_factory::add (std::shared_ptr<offer> o) {
-	check_add();
-	dispatch_add(*o);
-	offers_.push_back(std::make_unique<offer_wrapper<std::shared_ptr<offer>>>(curr_,std::move(o)));
+	auto && ctx = context();
+	auto && ref = *o;
+	if (!ctx.added) dispatch_add(ctx.so,ref);
+	ctx.offers.push_back(std::make_unique<offer_wrapper<std::shared_ptr<offer>>>(ctx.so,std::move(o)));
+	if (ctx.added) ctx.added->push_back(&ref);
+}
+
+void shared_library_offer_factory::concurrency (std::size_t n) noexcept {
+	concurrency_ = (n == 0U) ? 1U : n;
+}
+
+std::size_t shared_library_offer_factory::concurrency () const noexcept {
+	return concurrency_;
 }
 
 }
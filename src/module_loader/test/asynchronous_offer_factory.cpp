@@ -0,0 +1,144 @@
+#include <module_loader/asynchronous_offer_factory.hpp>
+#include <module_loader/dag_resolver.hpp>
+#include <module_loader/in_place_offer.hpp>
+#include <module_loader/offer.hpp>
+#include <module_loader/offer_factory.hpp>
+#include <module_loader/queue_offer_factory.hpp>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <catch.hpp>
+
+namespace module_loader {
+namespace test {
+namespace {
+
+class throwing_offer_factory : public offer_factory {
+private:
+	queue_offer_factory q_;
+public:
+	void add (std::unique_ptr<offer> o) {
+		q_.add(std::move(o));
+	}
+	virtual std::unique_ptr<offer> next () override {
+		auto retr = q_.next();
+		if (!retr) throw std::runtime_error("Exhausted");
+		return retr;
+	}
+	virtual std::shared_ptr<offer> next_shared () override {
+		return std::shared_ptr<offer>(next().release());
+	}
+};
+
+SCENARIO("module_loader::asynchronous_offer_factory objects yield the module_loader::offer objects of the wrapped module_loader::offer_factory in order","[module_loader][asynchronous_offer_factory]") {
+	GIVEN("A module_loader::asynchronous_offer_factory which wraps a module_loader::offer_factory which yields two module_loader::offer objects") {
+		queue_offer_factory q;
+		std::unique_ptr<offer> ptr(std::make_unique<in_place_offer<int>>());
+		offer * first = ptr.get();
+		q.add(std::move(ptr));
+		ptr = std::make_unique<in_place_offer<double>>();
+		offer * second = ptr.get();
+		q.add(std::move(ptr));
+		asynchronous_offer_factory factory(q);
+		THEN("module_loader::asynchronous_offer_factory::next yields them in order followed by null") {
+			auto a = factory.next();
+			CHECK(a.get() == first);
+			auto b = factory.next_shared();
+			CHECK(b.get() == second);
+			CHECK_FALSE(factory.next());
+			CHECK_FALSE(factory.next_shared());
+		}
+	}
+	GIVEN("A module_loader::asynchronous_offer_factory which wraps a module_loader::offer_factory which is never drained") {
+		queue_offer_factory q;
+		q.add(std::make_unique<in_place_offer<int>>());
+		THEN("It may be destroyed") {
+			asynchronous_offer_factory factory(q);
+		}
+	}
+}
+
+SCENARIO("module_loader::asynchronous_offer_factory objects return module_loader::offer objects in batches","[module_loader][asynchronous_offer_factory]") {
+	GIVEN("A module_loader::asynchronous_offer_factory which wraps a module_loader::offer_factory which yields three module_loader::offer objects and then throws") {
+		throwing_offer_factory t;
+		t.add(std::make_unique<in_place_offer<int>>());
+		t.add(std::make_unique<in_place_offer<int>>());
+		t.add(std::make_unique<in_place_offer<int>>());
+		asynchronous_offer_factory factory(t);
+		offer_factory::batch_type batch;
+		THEN("The exception is thrown rather than a short batch being returned") {
+			CHECK(factory.next_batch(batch,2) == 2U);
+			CHECK_THROWS_AS(factory.next_batch(batch,2),std::runtime_error);
+			CHECK(batch.size() == 3U);
+			CHECK(factory.next_batch(batch,2) == 0U);
+		}
+	}
+}
+
+SCENARIO("module_loader::dag_resolver objects propagate exceptions thrown by the module_loader::offer_factory wrapped by a module_loader::asynchronous_offer_factory","[module_loader][asynchronous_offer_factory]") {
+	GIVEN("A module_loader::dag_resolver whose module_loader::asynchronous_offer_factory wraps a module_loader::offer_factory which yields a module_loader::offer and then throws") {
+		throwing_offer_factory t;
+		t.add(std::make_unique<in_place_offer<int>>());
+		asynchronous_offer_factory factory(t);
+		dag_resolver resolver(factory);
+		THEN("module_loader::dag_resolver::resolve throws") {
+			CHECK_THROWS_AS(resolver.resolve(),std::runtime_error);
+		}
+	}
+}
+
+SCENARIO("module_loader::asynchronous_offer_factory objects propagate exceptions thrown by the wrapped module_loader::offer_factory","[module_loader][asynchronous_offer_factory]") {
+	GIVEN("A module_loader::asynchronous_offer_factory which wraps a module_loader::offer_factory which yields a module_loader::offer and then throws") {
+		throwing_offer_factory t;
+		t.add(std::make_unique<in_place_offer<int>>());
+		asynchronous_offer_factory factory(t);
+		THEN("The module_loader::offer is yielded before the exception is thrown") {
+			CHECK(factory.next());
+			CHECK_THROWS_AS(factory.next(),std::runtime_error);
+			CHECK_FALSE(factory.next());
+		}
+	}
+}
+
+SCENARIO("module_loader::asynchronous_offer_factory objects may be consumed by a module_loader::dag_resolver","[module_loader][asynchronous_offer_factory]") {
+	GIVEN("A module_loader::dag_resolver whose module_loader::offer_factory is a module_loader::asynchronous_offer_factory") {
+		queue_offer_factory q;
+		q.add(std::make_unique<in_place_offer<double,int>>());
+		q.add(std::make_unique<in_place_offer<int>>());
+		asynchronous_offer_factory factory(q);
+		dag_resolver resolver(factory);
+		THEN("module_loader::dag_resolver::resolve succeeds") {
+			CHECK_NOTHROW(resolver.resolve());
+		}
+	}
+}
+
+SCENARIO("module_loader::asynchronous_offer_factory objects estimate the number of module_loader::offer objects which remain","[module_loader][asynchronous_offer_factory]") {
+	GIVEN("A module_loader::asynchronous_offer_factory which wraps a module_loader::offer_factory which yields three module_loader::offer objects") {
+		queue_offer_factory q;
+		q.add(std::make_unique<in_place_offer<int>>());
+		q.add(std::make_unique<in_place_offer<double>>());
+		q.add(std::make_unique<in_place_offer<float>>());
+		asynchronous_offer_factory aof(q);
+		THEN("module_loader::asynchronous_offer_factory::size_hint returns 3") {
+			CHECK(aof.size_hint() == 3U);
+		}
+		WHEN("A module_loader::offer is retrieved") {
+			auto ptr = aof.next();
+			REQUIRE(ptr);
+			THEN("module_loader::asynchronous_offer_factory::size_hint returns 2") {
+				CHECK(aof.size_hint() == 2U);
+			}
+			AND_WHEN("The remaining module_loader::offer objects are retrieved") {
+				while (aof.next());
+				THEN("module_loader::asynchronous_offer_factory::size_hint returns 0") {
+					CHECK(aof.size_hint() == 0U);
+				}
+			}
+		}
+	}
+}
+
+}
+}
+}
@@ -0,0 +1,158 @@
+#include <module_loader/concurrent_directory_scanning_shared_library_factory.hpp>
+#include <boost/filesystem.hpp>
+#include <module_loader/counting_directory_scanning_shared_library_factory_observer.hpp>
+#include <module_loader/directory_entry_filter.hpp>
+#include <module_loader/whereami.hpp>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <catch.hpp>
+
+namespace module_loader {
+namespace test {
+namespace {
+
+class temporary_directory {
+private:
+	boost::filesystem::path path_;
+public:
+	temporary_directory () : path_(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()) {
+		boost::filesystem::create_directory(path_);
+	}
+	temporary_directory (const temporary_directory &) = delete;
+	temporary_directory & operator = (const temporary_directory &) = delete;
+	~temporary_directory () noexcept {
+		boost::system::error_code ec;
+		boost::filesystem::remove_all(path_,ec);
+	}
+	const boost::filesystem::path & path () const noexcept {
+		return path_;
+	}
+};
+
+SCENARIO("module_loader::concurrent_directory_scanning_shared_library_factory objects traverse all shared libraries in their managed directories","[module_loader][concurrent_directory_scanning_shared_library_factory]") {
+	counting_directory_scanning_shared_library_factory_observer o;
+	concurrent_directory_scanning_shared_library_factory scanner(o);
+	GIVEN("A module_loader::concurrent_directory_scanning_shared_library_factory which does not traverse any directories") {
+		WHEN("module_loader::concurrent_directory_scanning_shared_library_factory::next is invoked") {
+			auto so = scanner.next();
+			THEN("No boost::dll::shared_library is returned") {
+				CHECK_FALSE(so);
+			}
+			THEN("No events are dispatched") {
+				CHECK(o.begin_directory() == 0U);
+				CHECK(o.end_directory() == 0U);
+				CHECK(o.load() == 0U);
+			}
+		}
+	}
+	GIVEN("A module_loader::concurrent_directory_scanning_shared_library_factory which traverses a directory which contains shared libraries") {
+		auto path = current_executable_directory_path();
+		auto result = scanner.add(path);
+		CHECK(result);
+		WHEN("module_loader::concurrent_directory_scanning_shared_library_factory::next is invoked repeatedly") {
+			std::size_t i(0);
+			for (; scanner.next(); ++i);
+			THEN("The correct number of boost::dll::shared_library objects are yielded") {
+				CHECK(i == 7U);
+			}
+			THEN("The correct events are dispatched") {
+				CHECK(o.begin_directory() == 1U);
+				CHECK(o.end_directory() == 1U);
+				CHECK(o.load() == 7U);
+			}
+			THEN("Directories may not be added") {
+				CHECK_THROWS_AS(scanner.add(path),std::logic_error);
+			}
+		}
+		WHEN("Shared libraries are read ahead") {
+			scanner.readahead(2,true);
+			std::size_t i(0);
+			for (; scanner.next(); ++i);
+			THEN("The correct number of boost::dll::shared_library objects are yielded") {
+				CHECK(i == 7U);
+			}
+		}
+		WHEN("The same directory is added again") {
+			path /= "./";
+			result = scanner.add(path);
+			CHECK_FALSE(result);
+		}
+	}
+}
+
+SCENARIO("module_loader::concurrent_directory_scanning_shared_library_factory objects may scan subdirectories","[module_loader][concurrent_directory_scanning_shared_library_factory]") {
+	GIVEN("A directory which contains a shared library and a subdirectory which contains a shared library") {
+		temporary_directory dir;
+		auto sub = dir.path() / "sub";
+		boost::filesystem::create_directory(sub);
+		auto so = current_executable_directory_path() / "libshared_library_offer_factory_none.so";
+		boost::filesystem::copy_file(so,dir.path() / "a.so");
+		boost::filesystem::copy_file(so,sub / "b.so");
+		concurrent_directory_scanning_shared_library_factory scanner;
+		scanner.add(dir.path());
+		WHEN("It is scanned non-recursively") {
+			std::size_t i(0);
+			for (; scanner.next(); ++i);
+			THEN("Only the shared library in the directory itself is yielded") {
+				CHECK(i == 1U);
+			}
+		}
+		WHEN("It is scanned recursively") {
+			scanner.recursive(true);
+			std::size_t i(0);
+			for (; scanner.next(); ++i);
+			THEN("Both shared libraries are yielded") {
+				CHECK(i == 2U);
+			}
+		}
+	}
+}
+
+SCENARIO("module_loader::concurrent_directory_scanning_shared_library_factory objects scan many directories with a bounded number of threads","[module_loader][concurrent_directory_scanning_shared_library_factory]") {
+	GIVEN("More directories than threads, each of which contains a shared library") {
+		temporary_directory dir;
+		auto so = current_executable_directory_path() / "libshared_library_offer_factory_none.so";
+		concurrent_directory_scanning_shared_library_factory scanner;
+		scanner.concurrency(2);
+		CHECK(scanner.concurrency() == 2U);
+		for (char c = 'a'; c != 'g'; ++c) {
+			auto sub = dir.path() / std::string(1,c);
+			boost::filesystem::create_directory(sub);
+			boost::filesystem::copy_file(so,sub / "a.so");
+			scanner.add(sub);
+		}
+		WHEN("It is scanned") {
+			std::size_t i(0);
+			for (; scanner.next(); ++i);
+			THEN("The shared library in every directory is yielded") {
+				CHECK(i == 6U);
+			}
+			THEN("The number of threads may not be changed") {
+				CHECK_THROWS_AS(scanner.concurrency(1),std::logic_error);
+			}
+		}
+	}
+}
+
+SCENARIO("module_loader::concurrent_directory_scanning_shared_library_factory objects accept a module_loader::directory_entry_filter which determines which files to include and which to exclude","[module_loader][concurrent_directory_scanning_shared_library_factory]") {
+	GIVEN("A module_loader::concurrent_directory_scanning_shared_library_factory with a module_loader::directory_entry_filter which rejects all shared libraries and which scans a directory which contains shared libraries") {
+		class : public directory_entry_filter {
+			virtual bool check (const boost::filesystem::directory_entry &) override {
+				return false;
+			}
+		} filter;
+		concurrent_directory_scanning_shared_library_factory scanner(filter);
+		scanner.add(current_executable_directory_path());
+		WHEN("module_loader::concurrent_directory_scanning_shared_library_factory::next is invoked") {
+			auto so = scanner.next();
+			THEN("No boost::dll::shared_library is returned") {
+				CHECK_FALSE(so);
+			}
+		}
+	}
+}
+
+}
+}
+}
@@ -0,0 +1,184 @@
+#include <module_loader/concurrent_queue_offer_factory.hpp>
+#include <module_loader/in_place_offer.hpp>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <catch.hpp>
+
+namespace module_loader {
+namespace test {
+namespace {
+
+SCENARIO("module_loader::concurrent_queue_offer_factory objects return a null pointer when their queue is empty","[module_loader][concurrent_queue_offer_factory]") {
+	GIVEN("A module_loader::concurrent_queue_offer_factory") {
+		concurrent_queue_offer_factory qof;
+		THEN("module_loader::concurrent_queue_offer_factory::next returns a null std::unique_ptr") {
+			CHECK(!qof.next());
+		}
+		THEN("module_loader::concurrent_queue_offer_factory::next_shared returns a null std::shared_ptr") {
+			CHECK(!qof.next_shared());
+		}
+		THEN("module_loader::concurrent_queue_offer_factory::next_batch returns zero") {
+			offer_factory::batch_type batch;
+			CHECK(qof.next_batch(batch,4) == 0U);
+			CHECK(batch.empty());
+		}
+	}
+}
+
+SCENARIO("module_loader::concurrent_queue_offer_factory objects return module_loader::offer objects in the order in which they were enqueued","[module_loader][concurrent_queue_offer_factory]") {
+	GIVEN("A module_loader::concurrent_queue_offer_factory") {
+		concurrent_queue_offer_factory qof;
+		WHEN("Three module_loader::offer objects are enqueued") {
+			std::vector<offer *> ptrs;
+			for (std::size_t i = 0; i < 3U; ++i) {
+				std::unique_ptr<offer> ptr(std::make_unique<in_place_offer<int>>());
+				ptrs.push_back(ptr.get());
+				qof.add(std::move(ptr));
+			}
+			AND_WHEN("module_loader::concurrent_queue_offer_factory::next is invoked") {
+				auto ptr = qof.next();
+				THEN("The first module_loader::offer enqueued is returned") {
+					CHECK(ptr.get() == ptrs[0]);
+				}
+				AND_WHEN("Another module_loader::offer is enqueued and module_loader::concurrent_queue_offer_factory::next_batch is invoked") {
+					std::unique_ptr<offer> last(std::make_unique<in_place_offer<int>>());
+					ptrs.push_back(last.get());
+					qof.add(std::move(last));
+					offer_factory::batch_type batch;
+					auto n = qof.next_batch(batch,8);
+					THEN("The remaining module_loader::offer objects are returned in order") {
+						REQUIRE(n == 3U);
+						REQUIRE(batch.size() == 3U);
+						CHECK(batch[0].get() == ptrs[1]);
+						CHECK(batch[1].get() == ptrs[2]);
+						CHECK(batch[2].get() == ptrs[3]);
+					}
+				}
+			}
+		}
+	}
+}
+
+SCENARIO("module_loader::concurrent_queue_offer_factory objects may have module_loader::offer objects added from many threads","[module_loader][concurrent_queue_offer_factory]") {
+	GIVEN("A module_loader::concurrent_queue_offer_factory") {
+		concurrent_queue_offer_factory qof;
+		WHEN("Several threads each add module_loader::offer objects while they are being retrieved") {
+			constexpr std::size_t threads = 4;
+			constexpr std::size_t per_thread = 1000;
+			std::unordered_map<const offer *,std::pair<std::size_t,std::size_t>> added;
+			std::vector<std::vector<std::unique_ptr<offer>>> offers(threads);
+			for (std::size_t i = 0; i < threads; ++i) for (std::size_t j = 0; j < per_thread; ++j) {
+				offers[i].push_back(std::make_unique<in_place_offer<int>>());
+				added.emplace(offers[i].back().get(),std::make_pair(i,j));
+			}
+			std::vector<std::thread> ts;
+			for (auto && v : offers) ts.emplace_back([&] () {
+				for (auto && ptr : v) qof.add(std::move(ptr));
+			});
+			std::vector<std::shared_ptr<offer>> retrieved;
+			offer_factory::batch_type batch;
+			while (retrieved.size() != (threads * per_thread)) {
+				batch.clear();
+				qof.next_batch(batch,16);
+				for (auto && ptr : batch) retrieved.push_back(std::move(ptr));
+			}
+			for (auto && t : ts) t.join();
+			THEN("Every module_loader::offer is retrieved exactly once") {
+				CHECK(!qof.next());
+				std::unordered_map<const offer *,std::size_t> seen;
+				for (auto && ptr : retrieved) ++seen[ptr.get()];
+				CHECK(seen.size() == (threads * per_thread));
+				bool once = true;
+				for (auto && pair : seen) if (pair.second != 1U) once = false;
+				CHECK(once);
+			}
+			THEN("The module_loader::offer objects from each thread are retrieved in the order that thread added them") {
+				std::vector<std::size_t> next(threads,0);
+				bool ordered = true;
+				for (auto && ptr : retrieved) {
+					auto && pair = added.at(ptr.get());
+					if (next[pair.first] != pair.second) ordered = false;
+					++next[pair.first];
+				}
+				CHECK(ordered);
+			}
+		}
+	}
+}
+
+SCENARIO("module_loader::concurrent_queue_offer_factory objects yield module_loader::offer objects in an order which does not depend on how the threads which add them are scheduled","[module_loader][concurrent_queue_offer_factory]") {
+	GIVEN("Several threads, each of which is a different producer") {
+		constexpr std::size_t threads = 4;
+		constexpr std::size_t per_thread = 250;
+		auto run = [&] () {
+			concurrent_queue_offer_factory qof;
+			std::unordered_map<const offer *,std::pair<std::size_t,std::size_t>> added;
+			std::vector<std::vector<std::unique_ptr<offer>>> offers(threads);
+			for (std::size_t i = 0; i < threads; ++i) for (std::size_t j = 0; j < per_thread; ++j) {
+				offers[i].push_back(std::make_unique<in_place_offer<int>>());
+				added.emplace(offers[i].back().get(),std::make_pair(i,j));
+			}
+			std::vector<std::thread> ts;
+			//	Producers are numbered in the reverse of the
+			//	order in which their threads are started
+			for (std::size_t i = 0; i < threads; ++i) ts.emplace_back([&, i] () {
+				for (auto && ptr : offers[i]) qof.add(threads - i,std::move(ptr));
+			});
+			for (auto && t : ts) t.join();
+			std::vector<std::pair<std::size_t,std::size_t>> retr;
+			offer_factory::batch_type batch;
+			while (qof.next_batch(batch,16) != 0U) {
+				for (auto && ptr : batch) retr.push_back(added.at(ptr.get()));
+				batch.clear();
+			}
+			return retr;
+		};
+		WHEN("Each thread adds module_loader::offer objects and they are retrieved several times") {
+			auto first = run();
+			THEN("The module_loader::offer objects are yielded by producer and then in the order in which they were added") {
+				REQUIRE(first.size() == (threads * per_thread));
+				bool ordered = true;
+				for (std::size_t i = 0; i < first.size(); ++i) {
+					auto thread = threads - 1U - (i / per_thread);
+					if (first[i] != std::make_pair(thread,i % per_thread)) ordered = false;
+				}
+				CHECK(ordered);
+			}
+			THEN("The order is the same every time") {
+				for (std::size_t i = 0; i < 10U; ++i) CHECK(run() == first);
+			}
+		}
+	}
+}
+
+SCENARIO("module_loader::concurrent_queue_offer_factory objects report how many module_loader::offer objects remain","[module_loader][concurrent_queue_offer_factory]") {
+	GIVEN("A module_loader::concurrent_queue_offer_factory to which three module_loader::offer objects have been added") {
+		concurrent_queue_offer_factory qof;
+		CHECK(qof.size_hint() == 0U);
+		for (std::size_t i = 0; i < 3U; ++i) qof.add(i,std::make_unique<in_place_offer<int>>());
+		THEN("module_loader::concurrent_queue_offer_factory::size_hint returns 3") {
+			CHECK(qof.size_hint() == 3U);
+		}
+		WHEN("A module_loader::offer is retrieved") {
+			auto ptr = qof.next();
+			THEN("module_loader::concurrent_queue_offer_factory::size_hint returns 2") {
+				CHECK(qof.size_hint() == 2U);
+			}
+			AND_WHEN("The remaining module_loader::offer objects are retrieved") {
+				offer_factory::batch_type batch;
+				qof.next_batch(batch,8);
+				THEN("module_loader::concurrent_queue_offer_factory::size_hint returns 0") {
+					CHECK(qof.size_hint() == 0U);
+				}
+			}
+		}
+	}
+}
+
+}
+}
+}
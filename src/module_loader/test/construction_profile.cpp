@@ -0,0 +1,202 @@
+#include "make_function_offer.hpp"
+#include <module_loader/construction_profile.hpp>
+#include <module_loader/counting_resolver_observer.hpp>
+#include <module_loader/dag_resolver.hpp>
+#include <module_loader/error.hpp>
+#include <module_loader/function_offer.hpp>
+#include <module_loader/in_place_offer.hpp>
+#include <module_loader/queue_offer_factory.hpp>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <catch.hpp>
+
+namespace module_loader {
+namespace test {
+namespace {
+
+void add_offers (queue_offer_factory & of) {
+	of.add(make_function_offer([] () noexcept {	return 1;	}));
+	of.add(make_function_offer([] () noexcept {	return 2U;	}));
+	of.add(make_function_offer<int>([] (int i) noexcept {	return double(i);	}));
+	of.add(make_function_offer<unsigned>([] (unsigned u) noexcept {	return float(u);	}));
+	of.add(make_function_offer<double,float>([] (double d, float f) noexcept {	return static_cast<long>(d + f);	}));
+}
+
+SCENARIO("module_loader::construction_profile objects record how long fulfilling each module_loader::offer took","[module_loader][construction_profile]") {
+	GIVEN("A module_loader::construction_profile") {
+		in_place_offer<int> a;
+		in_place_offer<double> b;
+		construction_profile p;
+		CHECK(p.size() == 0U);
+		CHECK_FALSE(p.find(a));
+		WHEN("A duration is recorded") {
+			p.record(a,std::chrono::nanoseconds(5));
+			THEN("It may be retrieved") {
+				CHECK(p.size() == 1U);
+				auto d = p.find(a);
+				REQUIRE(d);
+				CHECK(*d == std::chrono::nanoseconds(5));
+				CHECK_FALSE(p.find(b));
+			}
+			AND_WHEN("Another duration is recorded for the same module_loader::offer") {
+				p.record(a,std::chrono::nanoseconds(7));
+				THEN("It replaces the first") {
+					CHECK(p.size() == 1U);
+					auto d = p.find(a);
+					REQUIRE(d);
+					CHECK(*d == std::chrono::nanoseconds(7));
+				}
+			}
+			AND_WHEN("It is written and read back") {
+				p.record(b,std::chrono::nanoseconds(11));
+				std::stringstream ss;
+				p.write(ss);
+				auto read = construction_profile::read(ss);
+				THEN("The durations are preserved") {
+					CHECK(read.size() == 2U);
+					auto d = read.find(a);
+					REQUIRE(d);
+					CHECK(*d == std::chrono::nanoseconds(5));
+					d = read.find(b);
+					REQUIRE(d);
+					CHECK(*d == std::chrono::nanoseconds(11));
+				}
+			}
+		}
+	}
+	GIVEN("Input which is not a module_loader::construction_profile") {
+		std::stringstream ss(std::string("MLPROF01\x01",9));
+		THEN("module_loader::construction_profile::read throws") {
+			CHECK_THROWS_AS(construction_profile::read(ss),error);
+		}
+	}
+}
+
+SCENARIO("module_loader::dag_resolver objects may construct objects concurrently","[module_loader][construction_profile][dag_resolver]") {
+	GIVEN("A module_loader::dag_resolver which constructs objects on several threads") {
+		queue_offer_factory of;
+		add_offers(of);
+		counting_resolver_observer o;
+		dag_resolver resolver(of,o);
+		resolver.concurrency(4);
+		CHECK(resolver.concurrency() == 4U);
+		construction_profile p;
+		resolver.profile(&p);
+		CHECK(resolver.profile() == &p);
+		WHEN("The dependency graph is resolved") {
+			resolver.resolve();
+			THEN("Each object is constructed exactly once") {
+				CHECK(o.begin_create() == 5U);
+				CHECK(o.create() == 5U);
+			}
+			THEN("The time taken to fulfill each module_loader::offer is recorded") {
+				CHECK(p.size() == 5U);
+			}
+			THEN("The order in which the objects were constructed may be replayed") {
+				auto plan = resolver.plan();
+				queue_offer_factory replay_of;
+				add_offers(replay_of);
+				dag_resolver replay(replay_of);
+				replay.plan(std::move(plan));
+				replay.resolve();
+				CHECK(replay.planned());
+			}
+			AND_WHEN("The dependency graph is resolved again using the recorded durations") {
+				resolver.resolve();
+				THEN("Each object is constructed exactly once") {
+					CHECK(o.create() == 10U);
+					CHECK(o.destroy() == 5U);
+				}
+			}
+		}
+		WHEN("The module_loader::dag_resolver is cleared") {
+			resolver.resolve();
+			resolver.clear();
+			THEN("Each object is destroyed") {
+				CHECK(o.destroy() == 5U);
+			}
+		}
+	}
+	GIVEN("A module_loader::dag_resolver which constructs objects on several threads one of which throws") {
+		queue_offer_factory of;
+		of.add(make_function_offer([] () noexcept {	return 1;	}));
+		of.add(make_function_offer([] () noexcept {	return 2U;	}));
+		of.add(make_function_offer<int>([] (int) -> double {	throw std::runtime_error("Failed");	}));
+		of.add(make_function_offer<unsigned>([] (unsigned u) noexcept {	return float(u);	}));
+		counting_resolver_observer o;
+		dag_resolver resolver(of,o);
+		resolver.concurrency(2);
+		THEN("module_loader::dag_resolver::resolve propagates the exception and destroys the objects which were constructed") {
+			CHECK_THROWS_AS(resolver.resolve(),std::runtime_error);
+			CHECK(o.create() == o.destroy());
+		}
+	}
+}
+
+SCENARIO("module_loader::dag_resolver objects construct the objects on the longest path first","[module_loader][construction_profile][dag_resolver]") {
+	GIVEN("A module_loader::dag_resolver which constructs objects on two threads and a module_loader::construction_profile in which one offer without dependents is much slower than two cheap chains") {
+		std::mutex m;
+		std::condition_variable cv;
+		std::vector<std::string> started;
+		auto start = [&] (const char * name) {
+			std::lock_guard<std::mutex> l(m);
+			started.push_back(name);
+			cv.notify_all();
+		};
+		//	The cheap objects do not complete until the slow
+		//	one has started so that the order in which the
+		//	objects start is determined by the order in which
+		//	they are scheduled.  The timeout prevents a
+		//	deadlock should the slow object not be scheduled
+		//	before they complete
+		auto cheap = [&] (const char * name) {
+			start(name);
+			std::unique_lock<std::mutex> l(m);
+			cv.wait_for(l,std::chrono::seconds(5),[&] () {
+				return std::find(started.begin(),started.end(),std::string("slow")) != started.end();
+			});
+		};
+		queue_offer_factory of;
+		std::vector<const offer *> offers;
+		auto add = [&] (std::unique_ptr<offer> ptr) {
+			offers.push_back(ptr.get());
+			of.add(std::move(ptr));
+		};
+		//	Without durations each chain outranks the slow
+		//	object and would be constructed first
+		add(make_function_offer([&] () {	cheap("a");	return 1;	}));
+		add(make_function_offer<int>([&] (int i) {	cheap("b");	return long(i);	}));
+		add(make_function_offer([&] () {	cheap("c");	return 2U;	}));
+		add(make_function_offer<unsigned>([&] (unsigned u) {	cheap("d");	return static_cast<unsigned long>(u);	}));
+		add(make_function_offer([&] () {	start("slow");	return 3.0;	}));
+		construction_profile p;
+		for (std::size_t i = 0; i < 4U; ++i) p.record(*offers[i],std::chrono::nanoseconds(1));
+		p.record(*offers[4],std::chrono::milliseconds(1));
+		dag_resolver resolver(of);
+		resolver.concurrency(2);
+		resolver.profile(&p);
+		WHEN("The dependency graph is resolved") {
+			resolver.resolve();
+			THEN("The slow object starts before the second cheap chain") {
+				REQUIRE(started.size() == 5U);
+				auto slow = std::find(started.begin(),started.end(),"slow");
+				auto c = std::find(started.begin(),started.end(),"c");
+				CHECK(slow < c);
+			}
+		}
+	}
+}
+
+}
+}
+}
@@ -1,3 +1,4 @@
+#include "make_function_offer.hpp"
 #include <module_loader/dag_resolver.hpp>
 #include <module_loader/counting_resolver_observer.hpp>
 #include <module_loader/function_offer.hpp>
@@ -6,6 +7,7 @@
 #include <module_loader/optional.hpp>
 #include <module_loader/unfulfilled_error.hpp>
 #include <module_loader/queue_offer_factory.hpp>
+#include <module_loader/resolver_observer.hpp>
 #include <cstddef>
 #include <memory>
 #include <type_traits>
@@ -47,11 +49,43 @@ SCENARIO("module_loader::dag_resolver objects reject dependency graphs which can
 	}
 }
 
-template <typename... Ts, typename F>
-std::unique_ptr<function_offer<std::decay_t<F>,Ts...>> make_function_offer (F && func) {
-	return std::make_unique<function_offer<std::decay_t<F>,Ts...>>(std::forward<F>(func));
+SCENARIO("module_loader::dag_resolver objects report each cycle in a dependency graph exactly once","[module_loader][dag_resolver]") {
+	GIVEN("A module_loader::dag_resolver whose associated module_loader::offer_factory yields module_loader::offer objects which form two disjoint cycles") {
+		queue_offer_factory of;
+		of.add(std::make_unique<in_place_offer<int,double>>());
+		of.add(std::make_unique<in_place_offer<double,int>>());
+		of.add(std::make_unique<in_place_offer<float,char>>());
+		of.add(std::make_unique<in_place_offer<char,short>>());
+		of.add(std::make_unique<in_place_offer<short,float>>());
+		dag_resolver resolver(of);
+		WHEN("module_loader::dag_resolver::resolve is invoked") {
+			optional<not_a_dag_error> ex;
+			try {
+				resolver.resolve();
+			} catch (const not_a_dag_error & e) {
+				ex.emplace(e);
+			}
+			THEN("A module_loader::not_a_dag_error is thrown") {
+				REQUIRE(ex);
+				AND_THEN("Each cycle is reported once") {
+					auto && cycles = ex->cycles();
+					REQUIRE(cycles.size() == 2U);
+					std::size_t two(0);
+					std::size_t three(0);
+					for (auto && cycle : cycles) {
+						if (cycle.size() == 2U) ++two;
+						if (cycle.size() == 3U) ++three;
+					}
+					CHECK(two == 1U);
+					CHECK(three == 1U);
+				}
+			}
+		}
+	}
 }
 
+using test::make_function_offer;
+
 SCENARIO("module_loader::dag_resolver objects resolve dependency graphs which are directed acyclic graphs","[module_loader][dag_resolver]") {
 	GIVEN("A module_loader::dag_resolver whose associated module_loader::offer_factory yields an acyclic dependency graph") {
 		queue_offer_factory of;
@@ -80,6 +114,7 @@ SCENARIO("module_loader::dag_resolver objects resolve dependency graphs which ar
 				CHECK(*i == 5);
 			}
 			THEN("The appropriate events are dispatched to the associated module_loader::resolver_observer") {
+				CHECK(ro.begin_create() == 2U);
 				CHECK(ro.create() == 2U);
 				CHECK(ro.resolve() == 1U);
 				CHECK(ro.destroy() == 0U);
@@ -87,6 +122,7 @@ SCENARIO("module_loader::dag_resolver objects resolve dependency graphs which ar
 			AND_WHEN("The module_loader::dag_resolver is destroyed") {
 				resolver = nullopt;
 				THEN("The appropriate events are dispatched to the associated module_loader::resolver_observer") {
+					CHECK(ro.begin_create() == 2U);
 					CHECK(ro.create() == 2U);
 					CHECK(ro.resolve() == 1U);
 					CHECK(ro.destroy() == 2U);
@@ -96,6 +132,120 @@ SCENARIO("module_loader::dag_resolver objects resolve dependency graphs which ar
 	}
 }
 
+SCENARIO("module_loader::dag_resolver objects dispatch events to module_loader::resolver_observer objects which do not handle the begin create event","[module_loader][dag_resolver]") {
+	GIVEN("A module_loader::dag_resolver whose module_loader::resolver_observer does not override module_loader::resolver_observer::on_begin_create") {
+		class : public resolver_observer {
+		public:
+			std::size_t created = 0;
+			virtual void on_resolve (resolve_event) override {	}
+			virtual void on_create (create_event) override {
+				++created;
+			}
+			virtual void on_destroy (destroy_event) override {	}
+		} ro;
+		queue_offer_factory of;
+		of.add(std::make_unique<in_place_offer<int>>());
+		dag_resolver resolver(of,ro);
+		WHEN("module_loader::dag_resolver::resolve is invoked") {
+			resolver.resolve();
+			THEN("The remaining events are dispatched") {
+				CHECK(ro.created == 1U);
+			}
+		}
+	}
+}
+
+SCENARIO("module_loader::dag_resolver objects order the providers of a type independent of the order in which they are yielded","[module_loader][dag_resolver]") {
+	GIVEN("A module_loader::dag_resolver whose associated module_loader::offer_factory yields a decorator after the offer it decorates") {
+		queue_offer_factory of;
+		of.add(make_function_offer([] () noexcept {	return 5;	}));
+		of.add(make_function_offer<int>([] (int i) noexcept {	return i * 2;	}));
+		optional<int> i;
+		of.add(make_function_offer<int>([&] (int j) noexcept {	i = j;	}));
+		dag_resolver resolver(of);
+		WHEN("module_loader::dag_resolver::resolve is invoked") {
+			resolver.resolve();
+			THEN("The decorated object is supplied") {
+				REQUIRE(i);
+				CHECK(*i == 10);
+			}
+		}
+	}
+	GIVEN("A module_loader::dag_resolver whose associated module_loader::offer_factory yields a decorator before the offer it decorates") {
+		queue_offer_factory of;
+		optional<int> i;
+		of.add(make_function_offer<int>([&] (int j) noexcept {	i = j;	}));
+		of.add(make_function_offer<int>([] (int i) noexcept {	return i * 2;	}));
+		of.add(make_function_offer([] () noexcept {	return 5;	}));
+		dag_resolver resolver(of);
+		WHEN("module_loader::dag_resolver::resolve is invoked") {
+			resolver.resolve();
+			THEN("The decorated object is supplied") {
+				REQUIRE(i);
+				CHECK(*i == 10);
+			}
+		}
+	}
+}
+
+SCENARIO("module_loader::dag_resolver objects may determine whether a dependency graph may be resolved without constructing any objects","[module_loader][dag_resolver]") {
+	GIVEN("A module_loader::dag_resolver whose associated module_loader::offer_factory yields module_loader::offer objects which form a dependency graph which cannot be resolved due to missing dependencies") {
+		queue_offer_factory of;
+		of.add(std::make_unique<in_place_offer<double,int>>());
+		dag_resolver resolver(of);
+		WHEN("module_loader::dag_resolver::try_resolve is invoked") {
+			auto result = resolver.try_resolve();
+			THEN("The missing dependency is reported") {
+				CHECK_FALSE(result);
+				CHECK(result.unfulfilled().size() == 1U);
+				CHECK(result.cycles().empty());
+			}
+		}
+	}
+	GIVEN("A module_loader::dag_resolver whose associated module_loader::offer_factory yields module_loader::offer objects which form a dependency graph which cannot be resolved due to a cycle") {
+		queue_offer_factory of;
+		of.add(std::make_unique<in_place_offer<int,double>>());
+		of.add(std::make_unique<in_place_offer<double,int>>());
+		dag_resolver resolver(of);
+		WHEN("module_loader::dag_resolver::try_resolve is invoked") {
+			auto result = resolver.try_resolve();
+			THEN("The cycle is reported") {
+				CHECK_FALSE(result);
+				CHECK(result.unfulfilled().empty());
+				CHECK(result.cycles().size() == 1U);
+			}
+		}
+	}
+	GIVEN("A module_loader::dag_resolver whose associated module_loader::offer_factory yields an acyclic dependency graph") {
+		queue_offer_factory of;
+		std::size_t n(0);
+		of.add(make_function_offer([&] () noexcept -> int {
+			++n;
+			return 5;
+		}));
+		of.add(make_function_offer<int>([&] (int) noexcept {	++n;	}));
+		counting_resolver_observer ro;
+		dag_resolver resolver(of,ro);
+		WHEN("module_loader::dag_resolver::try_resolve is invoked") {
+			auto result = resolver.try_resolve();
+			THEN("Success is reported") {
+				CHECK(result);
+			}
+			THEN("No objects are constructed") {
+				CHECK(n == 0U);
+				CHECK(ro.create() == 0U);
+			}
+			AND_WHEN("module_loader::dag_resolver::resolve is invoked") {
+				resolver.resolve();
+				THEN("The objects are constructed") {
+					CHECK(n == 2U);
+					CHECK(ro.create() == 2U);
+				}
+			}
+		}
+	}
+}
+
 }
 }
 }
@@ -34,12 +34,12 @@ SCENARIO("module_loader::directory_scanning_shared_library_factory objects trave
 			std::size_t i(0);
 			for (; scanner.next(); ++i);
 			THEN("The correct number of boost::dll::shared_library objects are yielded") {
-				CHECK(i == 6U);
+				CHECK(i == 7U);
 			}
 			THEN("The correct events are dispatched") {
 				CHECK(o.begin_directory() == 1U);
 				CHECK(o.end_directory() == 1U);
-				CHECK(o.load() == 6U);
+				CHECK(o.load() == 7U);
 			}
 		}
 		WHEN("The same directory is added again") {
@@ -50,12 +50,12 @@ SCENARIO("module_loader::directory_scanning_shared_library_factory objects trave
 				std::size_t i(0);
 				for (; scanner.next(); ++i);
 				THEN("The correct number of boost::dll::shared_library objects are yielded") {
-					CHECK(i == 6U);
+					CHECK(i == 7U);
 				}
 				THEN("The correct events are dispatched") {
 					CHECK(o.begin_directory() == 1U);
 					CHECK(o.end_directory() == 1U);
-					CHECK(o.load() == 6U);
+					CHECK(o.load() == 7U);
 				}
 			}
 		}
@@ -70,7 +70,7 @@ SCENARIO("module_loader::directory_scanning_shared_library_factory objects accep
 			}
 		} filter;
 		//	The directory scanned is the same that we scan
-		//	above and verify that it has 6
+		//	above and verify that it has 7
 		directory_scanning_shared_library_factory scanner(filter);
 		WHEN("module_loader::directory_scanning_shared_library_factory::next is invoked") {
 			auto so = scanner.next();
@@ -0,0 +1,80 @@
+#include <module_loader/load_policy.hpp>
+#include <boost/dll/shared_library.hpp>
+#include <module_loader/directory_scanning_shared_library_factory.hpp>
+#include <module_loader/directory_scanning_shared_library_factory_observer.hpp>
+#include <module_loader/queue_shared_library_factory.hpp>
+#include <module_loader/whereami.hpp>
+#include <chrono>
+#include <catch.hpp>
+
+namespace module_loader {
+namespace test {
+namespace {
+
+SCENARIO("module_loader::load_policy objects determine the mode with which shared libraries are opened","[module_loader][load_policy]") {
+	GIVEN("A default module_loader::load_policy") {
+		load_policy policy;
+		THEN("It uses lazy binding and local symbols") {
+			CHECK(policy.bind() == load_policy::binding::lazy);
+			CHECK(policy.symbols() == load_policy::visibility::local);
+			CHECK_FALSE(policy.deep_bind());
+			CHECK_FALSE(policy.no_delete());
+		}
+		WHEN("It is made to bind immediately and keep shared libraries mapped") {
+			policy.bind(load_policy::binding::now);
+			policy.no_delete(true);
+			THEN("The mode reflects this") {
+				auto mode = policy.mode();
+				CHECK((mode & boost::dll::load_mode::rtld_now) == boost::dll::load_mode::rtld_now);
+			}
+			AND_WHEN("A shared library is added to a module_loader::queue_shared_library_factory which uses it") {
+				queue_shared_library_factory qslf(policy);
+				qslf.add(current_executable_directory_path() / "libshared_library_offer_factory_success."
+					#ifdef _WIN32
+					"dll"
+					#else
+					"so"
+					#endif
+				);
+				THEN("The shared library is opened") {
+					CHECK(qslf.next());
+				}
+			}
+		}
+	}
+}
+
+SCENARIO("module_loader::directory_scanning_shared_library_factory objects report how long opening each shared library took","[module_loader][load_policy][directory_scanning_shared_library_factory]") {
+	GIVEN("A module_loader::directory_scanning_shared_library_factory with a module_loader::load_policy") {
+		class : public directory_scanning_shared_library_factory_observer {
+		public:
+			std::size_t loads = 0;
+			std::chrono::steady_clock::duration total = std::chrono::steady_clock::duration::zero();
+			virtual void on_begin_directory (begin_directory_event) override {	}
+			virtual void on_end_directory (end_directory_event) override {	}
+			virtual void on_load (load_event event) override {
+				++loads;
+				total += event.duration();
+			}
+		} o;
+		directory_scanning_shared_library_factory dsslf(o);
+		load_policy policy;
+		policy.bind(load_policy::binding::now);
+		dsslf.policy(policy);
+		dsslf.add(current_executable_directory_path());
+		WHEN("All shared libraries are opened") {
+			while (dsslf.next());
+			THEN("The duration of each is reported") {
+				CHECK(o.loads != 0U);
+				CHECK(o.total > std::chrono::steady_clock::duration::zero());
+			}
+			THEN("The policy is retained") {
+				CHECK(dsslf.policy().bind() == load_policy::binding::now);
+			}
+		}
+	}
+}
+
+}
+}
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <module_loader/function_offer.hpp>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace module_loader {
+namespace test {
+
+template <typename... Ts, typename F>
+std::unique_ptr<function_offer<std::decay_t<F>,Ts...>> make_function_offer (F && func) {
+	return std::make_unique<function_offer<std::decay_t<F>,Ts...>>(std::forward<F>(func));
+}
+
+}
+}
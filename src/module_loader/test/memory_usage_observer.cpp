@@ -0,0 +1,146 @@
+#include "make_function_offer.hpp"
+#include <module_loader/memory_usage_observer.hpp>
+#include <boost/dll/shared_library.hpp>
+#include <module_loader/dag_resolver.hpp>
+#include <module_loader/function_offer.hpp>
+#include <module_loader/optional.hpp>
+#include <module_loader/queue_offer_factory.hpp>
+#include <module_loader/queue_shared_library_factory.hpp>
+#include <module_loader/shared_library_offer_factory.hpp>
+#include <module_loader/whereami.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <catch.hpp>
+
+namespace module_loader {
+namespace test {
+namespace {
+
+constexpr std::size_t large = 1U << 20;
+
+SCENARIO("module_loader::memory_usage_observer objects attribute memory to the objects created by a resolver","[module_loader][memory_usage_observer]") {
+	GIVEN("A module_loader::dag_resolver with an associated module_loader::memory_usage_observer whose dependency graph contains a large object and a small object") {
+		queue_offer_factory of;
+		of.add(make_function_offer([] () {	return std::vector<char>(large);	}));
+		of.add(make_function_offer<std::vector<char>>([] (const std::vector<char> &) noexcept {	return 5;	}));
+		memory_usage_observer o;
+		optional<dag_resolver> resolver(in_place,of,o);
+		WHEN("module_loader::dag_resolver::resolve is invoked") {
+			resolver->resolve();
+			THEN("There is an entry for each object") {
+				auto objects = o.objects();
+				REQUIRE(objects.size() == 2U);
+				AND_THEN("The entries are sorted from largest to smallest") {
+					CHECK(objects[0].total() >= objects[1].total());
+					#ifdef __GLIBC__
+					CHECK(objects[0].heap() >= large);
+					CHECK(objects[1].heap() < large);
+					#endif
+				}
+				AND_THEN("Objects are not charged for mapped memory") {
+					CHECK(objects[0].mapped() == 0U);
+					CHECK(objects[1].mapped() == 0U);
+				}
+			}
+			THEN("The report lists each object") {
+				std::ostringstream ss;
+				o.report(ss);
+				CHECK(ss.str().find("Objects (2)") != std::string::npos);
+			}
+			AND_WHEN("The module_loader::dag_resolver is destroyed") {
+				resolver = nullopt;
+				THEN("There are no entries") {
+					CHECK(o.objects().empty());
+				}
+			}
+		}
+	}
+}
+
+SCENARIO("module_loader::memory_usage_observer objects do not attribute heap usage to objects created concurrently","[module_loader][memory_usage_observer]") {
+	GIVEN("A module_loader::dag_resolver which constructs objects on two threads with an associated module_loader::memory_usage_observer and two large objects which are created at the same time") {
+		std::mutex m;
+		std::condition_variable cv;
+		std::size_t started(0);
+		//	Neither allocates until both have begun so that
+		//	their creations overlap
+		auto both = [&] () {
+			std::unique_lock<std::mutex> l(m);
+			++started;
+			cv.notify_all();
+			cv.wait_for(l,std::chrono::seconds(5),[&] () noexcept {	return started >= 2U;	});
+		};
+		queue_offer_factory of;
+		of.add(make_function_offer([&] () {
+			both();
+			return std::vector<char>(large);
+		}));
+		of.add(make_function_offer([&] () {
+			both();
+			return std::string(large,'a');
+		}));
+		memory_usage_observer o;
+		dag_resolver resolver(of,o);
+		resolver.concurrency(2);
+		WHEN("module_loader::dag_resolver::resolve is invoked") {
+			resolver.resolve();
+			THEN("There is an entry for each object") {
+				auto objects = o.objects();
+				REQUIRE(objects.size() == 2U);
+				REQUIRE(started == 2U);
+				AND_THEN("Neither is charged for heap") {
+					CHECK(objects[0].heap() == 0U);
+					CHECK(objects[1].heap() == 0U);
+				}
+			}
+			AND_WHEN("The dependency graph is resolved again on one thread") {
+				resolver.concurrency(1);
+				resolver.resolve();
+				THEN("Heap usage is attributed") {
+					auto objects = o.objects();
+					REQUIRE(objects.size() == 2U);
+					#ifdef __GLIBC__
+					CHECK(objects[0].heap() >= large);
+					CHECK(objects[1].heap() >= large);
+					#endif
+				}
+			}
+		}
+	}
+}
+
+SCENARIO("module_loader::memory_usage_observer objects attribute memory to the shared libraries loaded by a module_loader::shared_library_offer_factory","[module_loader][memory_usage_observer]") {
+	GIVEN("A module_loader::shared_library_offer_factory with an associated module_loader::memory_usage_observer") {
+		auto path = current_executable_directory_path() / "libshared_library_offer_factory_success."
+		#ifdef _WIN32
+		"dll"
+		#else
+		"so"
+		#endif
+		;
+		queue_shared_library_factory qslf;
+		qslf.add(boost::dll::shared_library(path));
+		memory_usage_observer o;
+		shared_library_offer_factory slof(qslf,o);
+		WHEN("The shared library is loaded") {
+			while (slof.next());
+			THEN("There is an entry for the shared library") {
+				auto libraries = o.libraries();
+				REQUIRE(libraries.size() == 1U);
+				#ifdef __GLIBC__
+				CHECK(libraries[0].mapped() != 0U);
+				#endif
+			}
+		}
+	}
+}
+
+}
+}
+}
@@ -0,0 +1,45 @@
+#include <module_loader/not_a_dag_error.hpp>
+#include <module_loader/in_place_offer.hpp>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <catch.hpp>
+
+namespace module_loader {
+namespace test {
+namespace {
+
+TEST_CASE("module_loader::not_a_dag_error rejects invalid constructor arguments","[module_loader][not_a_dag_error]") {
+	CHECK_THROWS_AS(not_a_dag_error(not_a_dag_error::cycles_type{}),std::logic_error);
+	not_a_dag_error::cycles_type cycles;
+	cycles.emplace_back();
+	CHECK_THROWS_AS(not_a_dag_error(std::move(cycles)),std::logic_error);
+}
+
+SCENARIO("module_loader::not_a_dag_error generates an error message appropriate for the given cycles","[module_loader][not_a_dag_error]") {
+	GIVEN("A module_loader::not_a_dag_error with one cycle") {
+		not_a_dag_error::cycle_type cycle;
+		cycle.push_back(std::make_shared<in_place_offer<int,double>>());
+		cycle.push_back(std::make_shared<in_place_offer<double,int>>());
+		not_a_dag_error::cycles_type cycles;
+		cycles.push_back(std::move(cycle));
+		not_a_dag_error error(std::move(cycles));
+		std::string expected(
+			"Dependency graph not a directed acyclic graph (DAG) due to the following cycles:\n"
+			"#1: int => double => int"
+		);
+		THEN("Its error message is correct") {
+			CHECK(error.what() == expected);
+		}
+		THEN("Copies have the same error message") {
+			auto copy = error;
+			CHECK(copy.what() == expected);
+			CHECK(error.what() == expected);
+		}
+	}
+}
+
+}
+}
+}
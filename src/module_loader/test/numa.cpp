@@ -0,0 +1,54 @@
+#include <module_loader/numa.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <catch.hpp>
+
+namespace module_loader {
+namespace test {
+namespace {
+
+SCENARIO("module_loader::numa_nodes determines at least one NUMA node","[module_loader][numa]") {
+	GIVEN("The NUMA nodes") {
+		auto nodes = numa_nodes();
+		THEN("There is at least one") {
+			CHECK_FALSE(nodes.empty());
+		}
+		THEN("They are in ascending order") {
+			CHECK(std::is_sorted(nodes.begin(),nodes.end()));
+		}
+	}
+}
+
+SCENARIO("module_loader::run_on_numa_node invokes a function","[module_loader][numa]") {
+	GIVEN("A NUMA node") {
+		auto node = numa_nodes().front();
+		WHEN("module_loader::run_on_numa_node is invoked with a function which returns") {
+			bool invoked = false;
+			run_on_numa_node(node,[&] () {	invoked = true;	});
+			THEN("The function is invoked") {
+				CHECK(invoked);
+			}
+		}
+		WHEN("module_loader::run_on_numa_node is invoked with a function which throws") {
+			THEN("The exception is thrown on the calling thread") {
+				CHECK_THROWS_AS(run_on_numa_node(node,[] () {	throw std::runtime_error("test");	}),std::runtime_error);
+			}
+		}
+	}
+	GIVEN("A NUMA node which does not exist") {
+		WHEN("module_loader::run_on_numa_node is invoked") {
+			auto id = std::this_thread::get_id();
+			std::thread::id invoked;
+			run_on_numa_node(1U << 20U,[&] () {	invoked = std::this_thread::get_id();	});
+			THEN("The function is invoked on the calling thread") {
+				CHECK(invoked == id);
+			}
+		}
+	}
+}
+
+}
+}
+}
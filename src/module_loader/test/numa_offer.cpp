@@ -0,0 +1,41 @@
+#include <module_loader/numa_offer.hpp>
+#include <module_loader/in_place_offer.hpp>
+#include <module_loader/numa.hpp>
+#include <module_loader/object.hpp>
+#include <module_loader/offer.hpp>
+#include <memory>
+#include <typeinfo>
+#include <catch.hpp>
+
+namespace module_loader {
+namespace test {
+namespace {
+
+SCENARIO("module_loader::numa_offer objects fulfill the offers they wrap","[module_loader][numa_offer]") {
+	GIVEN("A module_loader::numa_offer wrapping a module_loader::in_place_offer") {
+		auto node = numa_nodes().front();
+		auto o = make_numa_offer(std::unique_ptr<offer>(std::make_unique<in_place_offer<int>>()),node);
+		THEN("It provides the same type") {
+			CHECK(o->type() == typeid(int));
+			CHECK(o->requests().empty());
+		}
+		WHEN("It is fulfilled") {
+			auto obj = o->fulfill({});
+			THEN("An object of the appropriate type is returned") {
+				REQUIRE(obj);
+				CHECK(obj->type() == typeid(int));
+			}
+		}
+		WHEN("It is fulfilled to obtain a std::shared_ptr") {
+			auto obj = o->fulfill_shared({});
+			THEN("An object of the appropriate type is returned") {
+				REQUIRE(obj);
+				CHECK(obj->type() == typeid(int));
+			}
+		}
+	}
+}
+
+}
+}
+}
@@ -0,0 +1,88 @@
+#include "make_function_offer.hpp"
+#include <module_loader/offer_catalog.hpp>
+#include <module_loader/dag_resolver.hpp>
+#include <module_loader/function_offer.hpp>
+#include <module_loader/in_place_offer.hpp>
+#include <module_loader/queue_offer_factory.hpp>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <typeindex>
+#include <utility>
+#include <vector>
+#include <catch.hpp>
+
+namespace module_loader {
+namespace test {
+namespace {
+
+SCENARIO("module_loader::offer_catalog objects retrieve all module_loader::offer objects from a module_loader::offer_factory","[module_loader][offer_catalog]") {
+	GIVEN("A module_loader::offer_factory which yields an offer and a decorator thereof") {
+		queue_offer_factory of;
+		of.add(std::make_unique<in_place_offer<int>>());
+		of.add(std::make_unique<in_place_offer<double,int>>());
+		of.add(make_function_offer<int>([] (int i) noexcept {	return i;	}));
+		WHEN("A module_loader::offer_catalog is created therefrom") {
+			offer_catalog catalog(of);
+			THEN("The module_loader::offer_factory is exhausted") {
+				CHECK_FALSE(of.next());
+			}
+			THEN("All module_loader::offer objects are in the module_loader::offer_catalog in the order they were yielded") {
+				CHECK(catalog.offers().size() == 3U);
+			}
+			THEN("The decorator is ordered before the offer it decorates") {
+				auto && providers = catalog.providers();
+				auto iter = providers.find(typeid(int));
+				REQUIRE(iter != providers.end());
+				auto && v = iter->second;
+				REQUIRE(v.size() == 2U);
+				CHECK(v[0] == 2U);
+				CHECK(v[1] == 0U);
+			}
+		}
+	}
+}
+
+SCENARIO("module_loader::dag_resolver objects may concurrently resolve dependency graphs from a single module_loader::offer_catalog","[module_loader][offer_catalog][dag_resolver]") {
+	GIVEN("A module_loader::offer_catalog") {
+		queue_offer_factory of;
+		std::atomic<std::size_t> created(0);
+		of.add(make_function_offer([&] () noexcept {
+			++created;
+			return 5;
+		}));
+		of.add(make_function_offer<int>([] (int i) noexcept {	return i * 2;	}));
+		std::atomic<std::size_t> wrong(0);
+		of.add(make_function_offer<int>([&] (int i) noexcept {	if (i != 10) ++wrong;	}));
+		offer_catalog catalog(of);
+		WHEN("Several module_loader::dag_resolver objects are created from it and resolved on different threads") {
+			constexpr std::size_t threads = 4;
+			std::atomic<std::size_t> failed(0);
+			std::vector<std::thread> ts;
+			for (std::size_t i = 0; i < threads; ++i) ts.emplace_back([&] () {
+				try {
+					dag_resolver resolver(catalog);
+					resolver.resolve();
+					//	Resolving again reuses the same nodes
+					resolver.resolve();
+				} catch (...) {
+					++failed;
+				}
+			});
+			for (auto && t : ts) t.join();
+			THEN("Each resolves independently") {
+				CHECK(failed == 0U);
+				CHECK(wrong == 0U);
+				CHECK(created == (threads * 2U));
+			}
+			THEN("The module_loader::offer_catalog is unchanged") {
+				CHECK(catalog.offers().size() == 3U);
+			}
+		}
+	}
+}
+
+}
+}
+}
@@ -2,6 +2,7 @@
 #include <module_loader/in_place_offer.hpp>
 #include <module_loader/queue_offer_factory.hpp>
 #include <memory>
+#include <typeinfo>
 #include <utility>
 #include <catch.hpp>
 
@@ -285,6 +286,54 @@ SCENARIO("module_loader::offer_factory_composite objects aggregate the sequence
 	}
 }
 
+SCENARIO("module_loader::offer_factory_composite objects forward batch retrieval","[module_loader][offer_factory_composite]") {
+	GIVEN("A module_loader::offer_factory_composite which contains two module_loader::offer_factory objects which each yield two module_loader::offer objects") {
+		queue_offer_factory a;
+		a.add(std::make_unique<in_place_offer<int>>());
+		a.add(std::make_unique<in_place_offer<int>>());
+		queue_offer_factory b;
+		b.add(std::make_unique<in_place_offer<double>>());
+		b.add(std::make_unique<in_place_offer<double>>());
+		offer_factory_composite factory;
+		factory.add(a);
+		factory.add(b);
+		WHEN("module_loader::offer_factory_composite::next_batch is invoked for three module_loader::offer objects") {
+			offer_factory::batch_type batch;
+			auto n = factory.next_batch(batch,3);
+			THEN("Three module_loader::offer objects are returned in order") {
+				CHECK(n == 3U);
+				REQUIRE(batch.size() == 3U);
+				CHECK(batch[0]->type() == typeid(int));
+				CHECK(batch[1]->type() == typeid(int));
+				CHECK(batch[2]->type() == typeid(double));
+			}
+			AND_WHEN("module_loader::offer_factory_composite::next_batch is invoked again") {
+				n = factory.next_batch(batch,3);
+				THEN("The remaining module_loader::offer is returned") {
+					CHECK(n == 1U);
+					CHECK(batch.size() == 4U);
+				}
+			}
+		}
+	}
+}
+
+SCENARIO("module_loader::offer_factory_composite objects sum the size hints of underlying module_loader::offer_factory objects","[module_loader][offer_factory_composite]") {
+	GIVEN("A module_loader::offer_factory_composite with two module_loader::queue_offer_factory objects") {
+		queue_offer_factory a;
+		a.add(std::make_unique<in_place_offer<int>>());
+		queue_offer_factory b;
+		b.add(std::make_unique<in_place_offer<int>>());
+		b.add(std::make_unique<in_place_offer<int>>());
+		offer_factory_composite c;
+		c.add(a);
+		c.add(b);
+		THEN("module_loader::offer_factory_composite::size_hint returns the sum of their size hints") {
+			CHECK(c.size_hint() == 3U);
+		}
+	}
+}
+
 }
 }
 }
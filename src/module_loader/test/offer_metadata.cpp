@@ -0,0 +1,122 @@
+#include <module_loader/offer_metadata.hpp>
+#include <boost/filesystem.hpp>
+#include <module_loader/request.hpp>
+#include <module_loader/whereami.hpp>
+#include <string>
+#include <vector>
+#include <catch.hpp>
+
+namespace module_loader {
+namespace test {
+namespace {
+
+boost::filesystem::path get_path (const char * name) {
+	std::string filename("libshared_library_offer_factory_");
+	filename += name;
+	filename +=
+	#ifdef _WIN32
+	".dll"
+	#else
+	".so"
+	#endif
+	;
+	return current_executable_directory_path() / filename;
+}
+
+#ifdef __ELF__
+SCENARIO("module_loader::read_offer_metadata reads the records emitted by MODULE_LOADER_OFFER_METADATA","[module_loader][offer_metadata]") {
+	GIVEN("A shared library containing records") {
+		auto path = get_path("metadata");
+		WHEN("module_loader::read_offer_metadata is invoked") {
+			auto offers = read_offer_metadata(path);
+			THEN("Each record is returned") {
+				REQUIRE(offers.size() == 3U);
+				CHECK(offers[0].name() == "a");
+				CHECK(offers[0].provides() == offer_metadata::provides_type{"int"});
+				CHECK(offers[0].requests().empty());
+				CHECK(offers[1].name() == "b");
+				CHECK(offers[1].provides() == offer_metadata::provides_type{"double"});
+				REQUIRE(offers[1].requests().size() == 2U);
+				CHECK(offers[1].requests()[0] == "int");
+				CHECK(offers[1].requests()[1] == "std::map<int,int>");
+			}
+			THEN("Requests are bounded exactly once unless otherwise specified") {
+				REQUIRE(offers.size() == 3U);
+				CHECK(offers[1].bounds() == (offer_metadata::bounds_type{{1,1},{1,1}}));
+				CHECK(offers[2].name() == "c");
+				CHECK(offers[2].provides() == (offer_metadata::provides_type{"long","unsigned long"}));
+				CHECK(offers[2].requests() == (offer_metadata::requests_type{"double","float"}));
+				CHECK(offers[2].bounds() == (offer_metadata::bounds_type{{1,1},{0,request::infinity}}));
+			}
+		}
+	}
+	GIVEN("A shared library containing no records") {
+		auto path = get_path("success");
+		THEN("module_loader::read_offer_metadata returns no records") {
+			CHECK(read_offer_metadata(path).empty());
+		}
+	}
+}
+#endif
+
+SCENARIO("module_loader::required_libraries determines which shared libraries must be loaded","[module_loader][offer_metadata]") {
+	GIVEN("Records from several shared libraries") {
+		library_metadata libraries;
+		libraries["a"].emplace_back("a",offer_metadata::provides_type{"int"},offer_metadata::requests_type{"double"});
+		libraries["b"].emplace_back("b",offer_metadata::provides_type{"double"},offer_metadata::requests_type{});
+		libraries["c"].emplace_back("c",offer_metadata::provides_type{"float"},offer_metadata::requests_type{"int"});
+		libraries["d"].emplace_back("d",offer_metadata::provides_type{"double"},offer_metadata::requests_type{"char"});
+		libraries["d"].emplace_back("e",offer_metadata::provides_type{"char"},offer_metadata::requests_type{});
+		WHEN("module_loader::required_libraries is invoked") {
+			auto required = required_libraries(libraries,{"int"});
+			THEN("Exactly those shared libraries needed to fulfill the requests are required") {
+				CHECK(required.size() == 3U);
+				CHECK(required.count("a") == 1U);
+				CHECK(required.count("b") == 1U);
+				CHECK(required.count("d") == 1U);
+			}
+		}
+	}
+}
+
+SCENARIO("module_loader::required_libraries matches types however they are spaced and qualified","[module_loader][offer_metadata]") {
+	GIVEN("Records which spell the same types differently") {
+		library_metadata libraries;
+		libraries["a"].emplace_back("a",offer_metadata::provides_type{"std::map<int, int>"},offer_metadata::requests_type{"const ::std::string"});
+		libraries["b"].emplace_back("b",offer_metadata::provides_type{"const std::string"},offer_metadata::requests_type{});
+		WHEN("module_loader::required_libraries is invoked with yet another spelling") {
+			auto required = required_libraries(libraries,{"::std::map< int,int >"});
+			THEN("The spellings match") {
+				CHECK(required.size() == 2U);
+				CHECK(required.count("a") == 1U);
+				CHECK(required.count("b") == 1U);
+			}
+		}
+	}
+}
+
+SCENARIO("module_loader::required_libraries considers the bounds and provided types of each offer","[module_loader][offer_metadata]") {
+	GIVEN("A record which optionally requests a type and a record which provides a base") {
+		library_metadata libraries;
+		libraries["a"].emplace_back(
+			"a",
+			offer_metadata::provides_type{"derived","base"},
+			offer_metadata::requests_type{"int","double"},
+			offer_metadata::bounds_type{{1,1},{0,1}}
+		);
+		libraries["b"].emplace_back("b",offer_metadata::provides_type{"int"},offer_metadata::requests_type{});
+		libraries["c"].emplace_back("c",offer_metadata::provides_type{"double"},offer_metadata::requests_type{});
+		WHEN("module_loader::required_libraries is invoked with a request for the base") {
+			auto required = required_libraries(libraries,{"base"});
+			THEN("Only the shared libraries needed to meet the lower bounds are required") {
+				CHECK(required.size() == 2U);
+				CHECK(required.count("a") == 1U);
+				CHECK(required.count("b") == 1U);
+			}
+		}
+	}
+}
+
+}
+}
+}
@@ -0,0 +1,131 @@
+#include "make_function_offer.hpp"
+#include <module_loader/per_thread_offer.hpp>
+#include <module_loader/dag_resolver.hpp>
+#include <module_loader/function_offer.hpp>
+#include <module_loader/in_place_offer.hpp>
+#include <module_loader/per_thread.hpp>
+#include <module_loader/queue_offer_factory.hpp>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <catch.hpp>
+
+namespace module_loader {
+namespace test {
+namespace {
+
+using recorder = std::vector<std::string>;
+using recorder_ref = std::reference_wrapper<recorder>;
+
+class counter {
+public:
+	recorder & r;
+	std::size_t value;
+	counter (recorder_ref r, int start) : r(r), value(std::size_t(start)) {
+		this->r.push_back("construct");
+	}
+	~counter () noexcept {
+		r.push_back("destroy");
+	}
+};
+
+SCENARIO("module_loader::per_thread_offer objects provide one replica per thread","[module_loader][per_thread_offer][per_thread]") {
+	GIVEN("A module_loader::dag_resolver with a module_loader::per_thread_offer and an offer which requests its object") {
+		recorder r;
+		queue_offer_factory of;
+		of.add(make_function_offer([&] () noexcept {	return std::ref(r);	}));
+		of.add(make_function_offer([] () noexcept {	return 5;	}));
+		of.add(std::make_unique<per_thread_offer<counter,recorder_ref,int>>());
+		per_thread<counter> * pt = nullptr;
+		of.add(make_function_offer<per_thread<counter>>([&] (per_thread<counter> & obj) noexcept {	pt = &obj;	}));
+		dag_resolver resolver(of);
+		WHEN("The dependency graph is resolved") {
+			resolver.resolve();
+			REQUIRE(pt);
+			THEN("No replicas are constructed") {
+				CHECK(pt->size() == 0U);
+				CHECK(r.empty());
+			}
+			AND_WHEN("The object is accessed from several threads") {
+				constexpr std::size_t threads = 4;
+				std::vector<counter *> ptrs(threads,nullptr);
+				std::vector<std::thread> ts;
+				for (std::size_t i = 0; i < threads; ++i) ts.emplace_back([&,i] () {
+					auto && c = pt->get();
+					//	Accessing again yields the same replica
+					if (&pt->get() == &c) ptrs[i] = &c;
+					c.value += i;
+				});
+				for (auto && t : ts) t.join();
+				THEN("One replica is constructed per thread") {
+					CHECK(pt->size() == threads);
+					std::set<counter *> unique(ptrs.begin(),ptrs.end());
+					CHECK(unique.size() == threads);
+					CHECK(unique.count(nullptr) == 0U);
+				}
+				THEN("Each replica is constructed with the requested objects") {
+					std::size_t sum = 0;
+					pt->for_each([&] (counter & c) noexcept {	sum += c.value;	});
+					CHECK(sum == ((threads * 5U) + 6U));
+				}
+				AND_WHEN("The module_loader::dag_resolver is cleared") {
+					resolver.clear();
+					THEN("All replicas are destroyed") {
+						REQUIRE(r.size() == (threads * 2U));
+						for (std::size_t i = threads; i < r.size(); ++i) CHECK(r[i] == "destroy");
+					}
+				}
+			}
+			AND_WHEN("The object is accessed from the same thread twice") {
+				auto && a = pt->get();
+				auto && b = pt->get();
+				THEN("The same replica is returned") {
+					CHECK(&a == &b);
+					CHECK(pt->size() == 1U);
+				}
+			}
+		}
+	}
+}
+
+SCENARIO("module_loader::per_thread objects of the same type may be accessed alternately from the same thread","[module_loader][per_thread]") {
+	GIVEN("Several module_loader::per_thread objects of the same type") {
+		std::size_t constructed = 0;
+		auto factory = [&] () {
+			++constructed;
+			return std::make_unique<int>(int(constructed));
+		};
+		std::vector<std::unique_ptr<per_thread<int>>> pts;
+		for (std::size_t i = 0; i < 3U; ++i) pts.push_back(std::make_unique<per_thread<int>>(factory));
+		WHEN("Their objects are accessed alternately") {
+			std::vector<int *> first;
+			for (auto && pt : pts) first.push_back(&pt->get());
+			std::vector<int *> second;
+			for (auto && pt : pts) second.push_back(&pt->get());
+			THEN("Each returns its own replica") {
+				CHECK(first == second);
+				std::set<int *> distinct(first.begin(),first.end());
+				CHECK(distinct.size() == pts.size());
+				CHECK(constructed == pts.size());
+			}
+			AND_WHEN("One is destroyed and another is constructed") {
+				pts.front().reset();
+				pts.front() = std::make_unique<per_thread<int>>(factory);
+				THEN("The new module_loader::per_thread constructs its own replica") {
+					auto && i = pts.front()->get();
+					CHECK(i == int(pts.size() + 1U));
+					CHECK(constructed == (pts.size() + 1U));
+				}
+			}
+		}
+	}
+}
+
+}
+}
+}
@@ -0,0 +1,102 @@
+#include <module_loader/pooled_offer.hpp>
+#include <module_loader/pool.hpp>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <typeinfo>
+#include <vector>
+#include <catch.hpp>
+
+namespace module_loader {
+namespace test {
+namespace {
+
+SCENARIO("module_loader::pooled_offer objects construct objects as if by module_loader::in_place_offer","[module_loader][pooled_offer]") {
+	GIVEN("A module_loader::pooled_offer") {
+		using offer_type = pooled_offer<double,int>;
+		offer_type offer;
+		int i = 5;
+		void * ptr = &i;
+		offer_type::fulfill_type fulfill;
+		fulfill.emplace_back(&ptr,1U);
+		THEN("Its name is correct") {
+			CHECK(offer.name() == "double");
+		}
+		WHEN("It is fulfilled") {
+			auto obj = offer.fulfill(fulfill);
+			THEN("An object is returned") {
+				REQUIRE(obj);
+				AND_THEN("It is of the correct type") {
+					REQUIRE(obj->type() == typeid(double));
+					AND_THEN("It is constructed as expected") {
+						CHECK(*static_cast<double *>(obj->get()) == 5.0);
+					}
+				}
+			}
+		}
+		WHEN("It is fulfilled through module_loader::offer::fulfill_shared") {
+			auto obj = offer.fulfill_shared(fulfill);
+			THEN("An object is returned") {
+				REQUIRE(obj);
+				CHECK(*static_cast<double *>(obj->get()) == 5.0);
+			}
+		}
+	}
+}
+
+SCENARIO("module_loader::pooled_offer objects recycle storage","[module_loader][pooled_offer]") {
+	GIVEN("A module_loader::pooled_offer") {
+		using offer_type = pooled_offer<int>;
+		offer_type offer;
+		offer_type::fulfill_type fulfill;
+		WHEN("It is fulfilled and the resulting object is destroyed") {
+			auto obj = offer.fulfill(fulfill);
+			REQUIRE(obj);
+			auto addr = obj.get();
+			obj.reset();
+			AND_WHEN("It is fulfilled again") {
+				obj = offer.fulfill(fulfill);
+				THEN("The storage of the first object is reused") {
+					CHECK(obj.get() == addr);
+				}
+			}
+		}
+		WHEN("It is fulfilled through module_loader::offer::fulfill_shared and the resulting object is destroyed") {
+			auto obj = offer.fulfill_shared(fulfill);
+			REQUIRE(obj);
+			auto addr = obj->get();
+			obj.reset();
+			AND_WHEN("It is fulfilled through module_loader::offer::fulfill_shared again") {
+				obj = offer.fulfill_shared(fulfill);
+				THEN("The storage of the first object is reused") {
+					CHECK(obj->get() == addr);
+				}
+			}
+		}
+	}
+}
+
+SCENARIO("module_loader::free_list retains a bounded number of blocks per thread","[module_loader][pooled_offer]") {
+	GIVEN("Blocks allocated on one thread") {
+		//	A size no other test uses so that the list
+		//	starts empty
+		using list = free_list<24,8>;
+		std::vector<void *> blocks;
+		for (std::size_t i = 0; i < (list::capacity + 10U); ++i) blocks.push_back(list::allocate());
+		WHEN("They are all released on another thread") {
+			std::size_t cached(0);
+			std::thread t([&] () {
+				for (auto ptr : blocks) list::deallocate(ptr);
+				cached = list::cached();
+			});
+			t.join();
+			THEN("That thread retains no more than module_loader::free_list::capacity of them") {
+				CHECK(cached == list::capacity);
+			}
+		}
+	}
+}
+
+}
+}
+}
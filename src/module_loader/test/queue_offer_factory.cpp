@@ -70,6 +70,56 @@ SCENARIO("module_loader::queue_offer_factory objects return module_loader::offer
 	}
 }
 
+SCENARIO("module_loader::queue_offer_factory objects return module_loader::offer objects in batches","[module_loader][queue_offer_factory]") {
+	GIVEN("A module_loader::queue_offer_factory with three module_loader::offer objects enqueued") {
+		queue_offer_factory qrf;
+		std::unique_ptr<offer> ptr(std::make_unique<in_place_offer<int>>());
+		offer * first = ptr.get();
+		qrf.add(std::move(ptr));
+		ptr = std::make_unique<in_place_offer<int>>();
+		offer * second = ptr.get();
+		qrf.add(std::move(ptr));
+		ptr = std::make_unique<in_place_offer<int>>();
+		offer * third = ptr.get();
+		qrf.add(std::move(ptr));
+		offer_factory::batch_type batch;
+		WHEN("module_loader::queue_offer_factory::next_batch is invoked for two module_loader::offer objects") {
+			auto n = qrf.next_batch(batch,2);
+			THEN("The first two module_loader::offer objects enqueued are returned") {
+				CHECK(n == 2U);
+				REQUIRE(batch.size() == 2U);
+				CHECK(batch[0].get() == first);
+				CHECK(batch[1].get() == second);
+			}
+			AND_WHEN("module_loader::queue_offer_factory::next_batch is invoked for two module_loader::offer objects") {
+				n = qrf.next_batch(batch,2);
+				THEN("The remaining module_loader::offer is appended") {
+					CHECK(n == 1U);
+					REQUIRE(batch.size() == 3U);
+					CHECK(batch[2].get() == third);
+				}
+			}
+		}
+	}
+}
+
+SCENARIO("module_loader::queue_offer_factory objects report the number of module_loader::offer objects which remain","[module_loader][queue_offer_factory]") {
+	GIVEN("A module_loader::queue_offer_factory with two module_loader::offer objects") {
+		queue_offer_factory qrf;
+		qrf.add(std::make_unique<in_place_offer<int>>());
+		qrf.add(std::make_unique<in_place_offer<int>>());
+		THEN("module_loader::queue_offer_factory::size_hint returns 2") {
+			CHECK(qrf.size_hint() == 2U);
+		}
+		WHEN("A module_loader::offer is retrieved") {
+			qrf.next();
+			THEN("module_loader::queue_offer_factory::size_hint returns 1") {
+				CHECK(qrf.size_hint() == 1U);
+			}
+		}
+	}
+}
+
 }
 }
 }
@@ -0,0 +1,23 @@
+#include <module_loader/readahead.hpp>
+#include <module_loader/whereami.hpp>
+#include <catch.hpp>
+
+namespace module_loader {
+namespace test {
+namespace {
+
+TEST_CASE("module_loader::readahead reports whether advice could be issued","[module_loader][readahead]") {
+	auto dir = current_executable_directory_path();
+	auto missing = dir / "this_file_does_not_exist.so";
+	CHECK_FALSE(readahead(missing));
+	CHECK_FALSE(readahead(missing,true));
+	#ifndef _WIN32
+	auto so = dir / "libshared_library_offer_factory_none.so";
+	CHECK(readahead(so));
+	CHECK(readahead(so,true));
+	#endif
+}
+
+}
+}
+}
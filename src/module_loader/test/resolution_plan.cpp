@@ -0,0 +1,161 @@
+#include "make_function_offer.hpp"
+#include <module_loader/resolution_plan.hpp>
+#include <module_loader/dag_resolver.hpp>
+#include <module_loader/error.hpp>
+#include <module_loader/function_offer.hpp>
+#include <module_loader/in_place_offer.hpp>
+#include <module_loader/offer.hpp>
+#include <module_loader/offer_decorator.hpp>
+#include <module_loader/optional.hpp>
+#include <module_loader/queue_offer_factory.hpp>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <typeindex>
+#include <utility>
+#include <catch.hpp>
+
+namespace module_loader {
+namespace test {
+namespace {
+
+void add_offers (queue_offer_factory & of, optional<int> & i) {
+	of.add(make_function_offer<int>([&] (int j) noexcept {	i = j;	}));
+	of.add(make_function_offer<int>([] (int j) noexcept {	return j * 2;	}));
+	of.add(make_function_offer([] () noexcept {	return 5;	}));
+}
+
+SCENARIO("module_loader::resolution_plan objects may be used to resolve identical dependency graphs","[module_loader][resolution_plan][dag_resolver]") {
+	GIVEN("A module_loader::resolution_plan obtained from a module_loader::dag_resolver which has resolved a dependency graph and written to a stream") {
+		std::stringstream ss;
+		{
+			queue_offer_factory of;
+			optional<int> i;
+			add_offers(of,i);
+			dag_resolver resolver(of);
+			resolver.resolve();
+			REQUIRE(i);
+			REQUIRE(*i == 10);
+			CHECK_FALSE(resolver.planned());
+			auto plan = resolver.plan();
+			CHECK(plan.size() == 3U);
+			plan.write(ss);
+			resolver.clear();
+			THEN("Retrieving the plan after the objects have been destroyed throws") {
+				CHECK_THROWS_AS(resolver.plan(),std::logic_error);
+			}
+		}
+		WHEN("The plan is read back and provided to a module_loader::dag_resolver with the same offers") {
+			auto plan = resolution_plan::read(ss);
+			queue_offer_factory of;
+			optional<int> i;
+			add_offers(of,i);
+			dag_resolver resolver(of);
+			resolver.plan(std::move(plan));
+			resolver.resolve();
+			THEN("The plan is used") {
+				CHECK(resolver.planned());
+			}
+			THEN("The objects are created correctly") {
+				REQUIRE(i);
+				CHECK(*i == 10);
+			}
+		}
+		WHEN("The plan is read back and provided to a module_loader::dag_resolver with different offers") {
+			auto plan = resolution_plan::read(ss);
+			queue_offer_factory of;
+			optional<int> i;
+			of.add(make_function_offer<int>([&] (int j) noexcept {	i = j;	}));
+			of.add(make_function_offer([] () noexcept {	return 7;	}));
+			dag_resolver resolver(of);
+			resolver.plan(std::move(plan));
+			resolver.resolve();
+			THEN("The plan is not used") {
+				CHECK_FALSE(resolver.planned());
+			}
+			THEN("The dependency graph is resolved as usual") {
+				REQUIRE(i);
+				CHECK(*i == 7);
+			}
+		}
+	}
+}
+
+class base {
+public:
+	virtual ~base () noexcept {	}
+};
+class derived : public base {	};
+
+//	Provides only the type of the object so that
+//	the offer may be made to gain its base
+class narrowed_offer : public offer_decorator<std::unique_ptr<offer>> {
+private:
+	provides_type provides_;
+public:
+	explicit narrowed_offer (std::unique_ptr<module_loader::offer> inner)
+		:	offer_decorator(std::move(inner)),
+			provides_{std::type_index(offer_decorator::type())}
+	{	}
+	virtual const provides_type & provides () const noexcept override {
+		return provides_;
+	}
+};
+
+SCENARIO("module_loader::resolution_plan objects are not used once the types an offer provides change","[module_loader][resolution_plan][dag_resolver]") {
+	GIVEN("A module_loader::resolution_plan obtained when an offer did not provide a base of its type") {
+		bool received_derived = false;
+		auto consumer = [&] () {
+			return make_function_offer<base>([&] (base & b) noexcept {	received_derived = dynamic_cast<derived *>(&b) != nullptr;	});
+		};
+		std::stringstream ss;
+		{
+			queue_offer_factory of;
+			of.add(std::make_unique<in_place_offer<base>>());
+			of.add(std::make_unique<narrowed_offer>(std::make_unique<in_place_offer<derived>>()));
+			of.add(consumer());
+			dag_resolver resolver(of);
+			resolver.resolve();
+			REQUIRE_FALSE(received_derived);
+			resolver.plan().write(ss);
+		}
+		WHEN("It is provided to a module_loader::dag_resolver where that offer provides the base") {
+			queue_offer_factory of;
+			of.add(std::make_unique<in_place_offer<base>>());
+			of.add(std::make_unique<in_place_offer<derived>>());
+			of.add(consumer());
+			dag_resolver resolver(of);
+			resolver.plan(resolution_plan::read(ss));
+			resolver.resolve();
+			THEN("The plan is not used") {
+				CHECK_FALSE(resolver.planned());
+			}
+			THEN("The request for the base is fulfilled as if there were no plan") {
+				CHECK(received_derived);
+			}
+		}
+	}
+}
+
+SCENARIO("module_loader::resolution_plan::read rejects streams which do not contain a plan","[module_loader][resolution_plan]") {
+	GIVEN("A stream which does not contain a plan") {
+		std::stringstream ss("not a plan");
+		THEN("module_loader::resolution_plan::read throws") {
+			CHECK_THROWS_AS(resolution_plan::read(ss),error);
+		}
+	}
+	GIVEN("A stream which contains a truncated plan") {
+		std::stringstream ss;
+		resolution_plan{}.write(ss);
+		auto str = ss.str();
+		str.pop_back();
+		std::stringstream truncated(str);
+		THEN("module_loader::resolution_plan::read throws") {
+			CHECK_THROWS_AS(resolution_plan::read(truncated),error);
+		}
+	}
+}
+
+}
+}
+}
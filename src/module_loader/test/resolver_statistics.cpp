@@ -0,0 +1,61 @@
+#include "make_function_offer.hpp"
+#include <module_loader/resolver_statistics.hpp>
+#include <module_loader/dag_resolver.hpp>
+#include <module_loader/function_offer.hpp>
+#include <module_loader/queue_offer_factory.hpp>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <catch.hpp>
+
+namespace module_loader {
+namespace test {
+namespace {
+
+SCENARIO("module_loader::dag_resolver objects record module_loader::resolver_statistics","[module_loader][resolver_statistics][dag_resolver]") {
+	GIVEN("A module_loader::dag_resolver with a module_loader::resolver_statistics") {
+		queue_offer_factory of;
+		of.add(make_function_offer([] () noexcept {	return 1;	}));
+		of.add(make_function_offer<int>([] (int i) noexcept {	return double(i);	}));
+		of.add(make_function_offer<int,double>([] (int, double) noexcept {	return 'a';	}));
+		resolver_statistics s;
+		dag_resolver resolver(of);
+		resolver.statistics(&s);
+		CHECK(resolver.statistics() == &s);
+		WHEN("The dependency graph is resolved") {
+			resolver.resolve();
+			THEN("The dependency graph is described") {
+				CHECK(s.resolutions() == 1U);
+				CHECK(s.nodes() == 3U);
+				CHECK(s.edges() == 3U);
+				CHECK(s.types() == 3U);
+				CHECK(s.providers(0) == 3U);
+				CHECK(s.providers(1) == 0U);
+				CHECK(s.max_fan_in() == 2U);
+				CHECK(s.max_fan_out() == 2U);
+				CHECK(s.depth() == 3U);
+			}
+			THEN("The critical path is no longer than the time spent creating objects") {
+				using phase = resolver_statistics::phase;
+				CHECK(s.critical_path() <= s.duration(phase::create));
+			}
+			AND_WHEN("module_loader::resolver_statistics::reset is invoked") {
+				s.reset();
+				THEN("Every figure is zero") {
+					CHECK(s.resolutions() == 0U);
+					CHECK(s.nodes() == 0U);
+					CHECK(s.edges() == 0U);
+					CHECK(s.depth() == 0U);
+					CHECK(s.critical_path() == std::chrono::nanoseconds::zero());
+					CHECK(s.duration(resolver_statistics::phase::create) == std::chrono::nanoseconds::zero());
+					CHECK(s.allocated(resolver_statistics::phase::create) == 0);
+				}
+			}
+		}
+	}
+}
+
+}
+}
+}
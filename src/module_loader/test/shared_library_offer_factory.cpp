@@ -1,11 +1,15 @@
 #include <module_loader/shared_library_offer_factory.hpp>
 #include <boost/dll/shared_library.hpp>
 #include <module_loader/counting_shared_library_offer_factory_observer.hpp>
+#include <module_loader/in_place_offer.hpp>
+#include <module_loader/offer.hpp>
 #include <module_loader/optional.hpp>
 #include <module_loader/queue_shared_library_factory.hpp>
 #include <module_loader/whereami.hpp>
 #include <cstddef>
+#include <memory>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <catch.hpp>
 
@@ -225,6 +229,85 @@ SCENARIO("module_loader::shared_library_offer_factory enumerates module_loader::
 	}
 }
 
+SCENARIO("module_loader::shared_library_offer_factory may invoke the load handlers of several shared libraries concurrently","[module_loader][shared_library_offer_factory]") {
+	queue_shared_library_factory qslf;
+	counting_shared_library_offer_factory_observer o;
+	shared_library_offer_factory slof(qslf,o);
+	slof.concurrency(4);
+	GIVEN("A module_loader::shared_library_offer_factory whose associated module_loader::shared_library_factory produces multiple boost::dll::shared_library objects") {
+		//	Should yield a total of five offers
+		qslf.add(get_shared_library("none"));
+		qslf.add(get_shared_library("multiple"));
+		qslf.add(get_shared_library("success"));
+		qslf.add(get_shared_library("multiple"));
+		qslf.add(get_shared_library("none"));
+		WHEN("All module_loader::offer objects are yielded") {
+			std::size_t n = 0;
+			for (auto offer = slof.next(); offer; offer = slof.next(), ++n);
+			THEN("The correct number of module_loader::offer objects are yielded") {
+				CHECK(n == 5U);
+			}
+			THEN("The appropriate events are dispatched") {
+				CHECK(o.begin_load() == 5U);
+				CHECK(o.end_load() == 5U);
+				CHECK(o.add() == 5U);
+			}
+		}
+	}
+	GIVEN("A module_loader::shared_library_offer_factory whose associated module_loader::shared_library_factory produces a boost::dll::shared_library whose \"load\" function throws an exception between ones which do not") {
+		qslf.add(get_shared_library("success"));
+		qslf.add(get_shared_library("throws"));
+		qslf.add(get_shared_library("multiple"));
+		WHEN("module_loader::shared_library_offer_factory::next is invoked") {
+			THEN("A module_loader::shared_library_offer_factory::error exception is thrown") {
+				CHECK_THROWS_AS(slof.next(),shared_library_offer_factory::error);
+			}
+			AND_WHEN("All module_loader::offer objects are subsequently yielded") {
+				CHECK_THROWS(slof.next());
+				std::size_t n = 0;
+				for (auto offer = slof.next(); offer; offer = slof.next(), ++n);
+				THEN("The module_loader::offer objects from the other boost::dll::shared_library objects are yielded") {
+					CHECK(n == 3U);
+				}
+				THEN("The appropriate events are dispatched") {
+					CHECK(o.begin_load() == 3U);
+					CHECK(o.end_load() == 2U);
+					CHECK(o.add() == 3U);
+				}
+			}
+		}
+	}
+}
+
+SCENARIO("module_loader::shared_library_offer_factory::add may only be invoked from a load handler","[module_loader][shared_library_offer_factory]") {
+	GIVEN("A module_loader::shared_library_offer_factory") {
+		queue_shared_library_factory qslf;
+		shared_library_offer_factory slof(qslf);
+		THEN("Invoking module_loader::shared_library_offer_factory::add throws") {
+			std::unique_ptr<offer> ptr = std::make_unique<in_place_offer<int>>();
+			CHECK_THROWS_AS(slof.add(std::move(ptr)),std::logic_error);
+		}
+	}
+}
+
+SCENARIO("module_loader::shared_library_offer_factory objects estimate the number of module_loader::offer objects which remain","[module_loader][shared_library_offer_factory]") {
+	GIVEN("A module_loader::shared_library_offer_factory whose associated module_loader::shared_library_factory produces a boost::dll::shared_library which provides two module_loader::offer objects") {
+		queue_shared_library_factory qslf;
+		qslf.add(get_shared_library("multiple"));
+		shared_library_offer_factory slof(qslf);
+		THEN("Before the shared library is loaded module_loader::shared_library_offer_factory::size_hint returns 0") {
+			CHECK(slof.size_hint() == 0U);
+		}
+		WHEN("A module_loader::offer is retrieved") {
+			auto offer = slof.next();
+			REQUIRE(offer);
+			THEN("module_loader::shared_library_offer_factory::size_hint returns 1") {
+				CHECK(slof.size_hint() == 1U);
+			}
+		}
+	}
+}
+
 }
 }
 }
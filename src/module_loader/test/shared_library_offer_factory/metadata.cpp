@@ -0,0 +1,19 @@
+#include <module_loader/function_offer.hpp>
+#include <module_loader/offer_metadata.hpp>
+#include <module_loader/shared_library_offer_factory.hpp>
+#include <map>
+
+MODULE_LOADER_OFFER_METADATA(a,"a",int);
+MODULE_LOADER_OFFER_METADATA(b,"b",double,int,::std::map<int, int>);
+MODULE_LOADER_BOUNDED_OFFER_METADATA(c,"c",(long, unsigned long),(1:1, 0:*),double,float);
+
+extern "C" {
+
+void load (module_loader::shared_library_offer_factory & slof) {
+	slof.add(module_loader::make_unique_function_offer([] () noexcept {	return 5;	},"a"));
+	slof.add(module_loader::make_unique_function_offer<int,std::map<int,int>>([] (int i, const std::map<int,int> &) noexcept {
+		return static_cast<double>(i);
+	},"b"));
+}
+
+}
@@ -0,0 +1,61 @@
+#include <module_loader/static_dependency_graph.hpp>
+#include <module_loader/in_place_offer.hpp>
+#include <module_loader/static_offer_set.hpp>
+#include <type_traits>
+#include <utility>
+#include <catch.hpp>
+
+namespace module_loader {
+namespace test {
+namespace {
+
+class base {
+public:
+	virtual ~base () noexcept {	}
+	virtual int get () const noexcept = 0;
+};
+
+class derived : public base {
+public:
+	virtual int get () const noexcept override {
+		return 5;
+	}
+};
+
+class user {
+public:
+	int value;
+	explicit user (base & b) noexcept : value(b.get()) {	}
+};
+
+using graph_type = static_dependency_graph<
+	in_place_offer<user,base>,
+	in_place_offer<double,int,user>,
+	in_place_offer<int>,
+	in_place_offer<derived>
+>;
+static_assert(graph_type::value,"Graph is not valid");
+static_assert(std::is_same<graph_type::order_type,std::index_sequence<2,3,0,1>>::value,"Incorrect construction order");
+static_assert(graph_type::provider<base>::index == 3U,"Incorrect provider");
+static_assert(graph_type::provider<double>::index == 1U,"Incorrect provider");
+static_assert(std::is_same<static_dependency_graph<>::order_type,std::index_sequence<>>::value,"Incorrect construction order");
+
+SCENARIO("module_loader::static_dependency_graph fulfills requests with objects of derived types","[module_loader][static_dependency_graph][static_offer_set]") {
+	GIVEN("A module_loader::static_offer_set one of whose offers requests a base class of the type of another") {
+		static_offer_set<
+			in_place_offer<user,base>,
+			in_place_offer<derived>
+		> set;
+		WHEN("module_loader::static_offer_set::create is invoked") {
+			set.create();
+			THEN("The request is fulfilled by the object of the derived type") {
+				CHECK(set.get<user>().value == 5);
+				CHECK(&set.get<base>() == &set.get<derived>());
+			}
+		}
+	}
+}
+
+}
+}
+}
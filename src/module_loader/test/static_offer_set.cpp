@@ -0,0 +1,119 @@
+#include <module_loader/static_offer_set.hpp>
+#include <module_loader/function_offer.hpp>
+#include <module_loader/in_place_offer.hpp>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <catch.hpp>
+
+namespace module_loader {
+namespace test {
+namespace {
+
+using recorder = std::vector<std::string>;
+using recorder_ref = std::reference_wrapper<recorder>;
+
+class a {
+public:
+	recorder & r;
+	explicit a (recorder_ref r) : r(r) {
+		this->r.push_back("construct a");
+	}
+	~a () noexcept {
+		r.push_back("destroy a");
+	}
+};
+
+class b {
+public:
+	recorder & r;
+	int value;
+	b (a & obj, int value) : r(obj.r), value(value) {
+		r.push_back("construct b");
+	}
+	~b () noexcept {
+		r.push_back("destroy b");
+	}
+};
+
+class c {
+public:
+	explicit c (b &) {
+		throw std::runtime_error("c");
+	}
+};
+
+SCENARIO("module_loader::static_offer_set objects construct objects in dependency order","[module_loader][static_offer_set]") {
+	GIVEN("A module_loader::static_offer_set whose offers are given in an order other than that in which they must be constructed") {
+		recorder r;
+		auto make_r = [&] () noexcept {	return std::ref(r);	};
+		auto make_i = [] () noexcept {	return 5;	};
+		using set_type = static_offer_set<
+			in_place_offer<b,a,int>,
+			in_place_offer<a,recorder_ref>,
+			function_offer<decltype(make_i)>,
+			function_offer<decltype(make_r)>
+		>;
+		static_assert(set_type::size == 4U,"Incorrect size");
+		WHEN("module_loader::static_offer_set::create is invoked") {
+			{
+				set_type set({},{},make_i,make_r);
+				CHECK_FALSE(set.created());
+				set.create();
+				THEN("The objects are constructed") {
+					CHECK(set.created());
+					CHECK(set.get<int>() == 5);
+					CHECK(set.get<b>().value == 5);
+					CHECK(&set.get<b>().r == &r);
+				}
+				THEN("Each object is constructed after the objects it requests") {
+					REQUIRE(r.size() == 2U);
+					CHECK(r[0] == "construct a");
+					CHECK(r[1] == "construct b");
+				}
+			}
+			AND_WHEN("The module_loader::static_offer_set is destroyed") {
+				THEN("The objects are destroyed in the reverse order of their construction") {
+					REQUIRE(r.size() == 4U);
+					CHECK(r[2] == "destroy b");
+					CHECK(r[3] == "destroy a");
+				}
+			}
+		}
+	}
+}
+
+SCENARIO("module_loader::static_offer_set objects destroy the objects already constructed if a constructor throws","[module_loader][static_offer_set]") {
+	GIVEN("A module_loader::static_offer_set one of whose objects throws when constructed") {
+		recorder r;
+		auto make_r = [&] () noexcept {	return std::ref(r);	};
+		static_offer_set<
+			in_place_offer<c,b>,
+			in_place_offer<b,a,int>,
+			in_place_offer<a,recorder_ref>,
+			function_offer<decltype(make_r)>,
+			in_place_offer<int>
+		> set({},{},{},make_r,{});
+		WHEN("module_loader::static_offer_set::create is invoked") {
+			THEN("The exception is propagated") {
+				CHECK_THROWS_AS(set.create(),std::runtime_error);
+				CHECK_FALSE(set.created());
+			}
+			THEN("The objects already constructed are destroyed in the reverse order of their construction") {
+				try {
+					set.create();
+				} catch (...) {	}
+				REQUIRE(r.size() == 4U);
+				CHECK(r[0] == "construct a");
+				CHECK(r[1] == "construct b");
+				CHECK(r[2] == "destroy b");
+				CHECK(r[3] == "destroy a");
+			}
+		}
+	}
+}
+
+}
+}
+}
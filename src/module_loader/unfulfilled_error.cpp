@@ -1,7 +1,7 @@
 #include <module_loader/unfulfilled_error.hpp>
 #include <module_loader/type_name.hpp>
 #include <cstddef>
-#include <sstream>
+#include <ostream>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -65,18 +65,16 @@ void unfulfilled_error::entry::to_string (std::ostream & os) const {
 	}
 }
 
-static std::string get_what (const unfulfilled_error::entries_type & entries) {
-	std::ostringstream ss;
-	ss << "Unable to fulfill all requests of the following offers:";
-	for (std::size_t i = 0; i < entries.size(); ++i) {
-		ss << "\n#" << i << ": ";
-		entries[i].to_string(ss);
+void unfulfilled_error::format (std::ostream & os) const {
+	os << "Unable to fulfill all requests of the following offers:";
+	for (std::size_t i = 0; i < entries_.size(); ++i) {
+		os << "\n#" << i << ": ";
+		entries_[i].to_string(os);
 	}
-	return ss.str();
 }
 
 unfulfilled_error::unfulfilled_error (entries_type entries)
-	:	resolver_error(get_what(entries)),
+	:	resolver_error(deferred_t{},"Unable to fulfill all requests"),
 		entries_(std::move(entries))
 {
 	if (entries_.empty()) throw std::logic_error("Expected at least one module_loader::unfulfilled_error::entry");